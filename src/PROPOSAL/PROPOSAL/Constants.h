@@ -51,6 +51,8 @@ extern const double IPREC2; // integration precision
 // interpolation parameters
 struct InterpolationSettings {
     static std::string TABLES_PATH;
+    static std::string TABLES_ARCHIVE;
+    static double ARCHIVE_FLOAT_PRECISION; // if positive, archive tables as float within this relative precision
     static double UPPER_ENERGY_LIM;
     static unsigned int NODES_DEDX;
     static unsigned int NODES_DE2DX;
@@ -58,6 +60,14 @@ struct InterpolationSettings {
     static unsigned int NODES_DNDX_V;
     static unsigned int NODES_UTILITY;
     static unsigned int NODES_RATE_INTERPOLANT;
+    static unsigned int TABLE_BUILD_THREADS; // 0: one per core
+    static bool LAZY_TABLES; // build tables segment-wise on first use
+    static bool PRECOMPUTE_LAZY_TABLES; // build all segments of these tables on construction
+    static double SEGMENT_DECADES; // width of these segments
+    static double TABLE_TOLERANCE; // if positive, nodes per segment are chosen for this relative accuracy
+    static unsigned int NODES_CHANNEL_TABLE; // if positive, channels of stochastic losses are chosen from a table
+    static bool DNDX_INVERSE_TABLES; // start solving for relative energy losses from tables of v(E, rate fraction)
+    static bool UTILITY_INVERSE_TABLES; // solve utility integrals for the energy with tables of their inverse
 };
 
 // propagation settings
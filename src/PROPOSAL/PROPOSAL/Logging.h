@@ -32,6 +32,7 @@
 #include <spdlog/spdlog.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -47,6 +48,7 @@ struct Logging {
 
     static logger_ptr Get(std::string const& name)
     {
+        std::lock_guard<std::mutex> lock(mutex);
         auto it = Logging::logger.find(name);
         if (it == logger.end())
             Logging::logger[name] = Logging::Create(name);
@@ -55,6 +57,7 @@ struct Logging {
 
     static void SetGlobalLoglevel(spdlog::level::level_enum loglevel)
     {
+        std::lock_guard<std::mutex> lock(mutex);
         for (auto& l : logger)
             l.second->set_level(loglevel);
         global_loglevel = loglevel;
@@ -69,5 +72,6 @@ private:
     }
 
     static spdlog::level::level_enum global_loglevel;
+    static std::mutex mutex;
 };
 } // namespace PROPOSAL
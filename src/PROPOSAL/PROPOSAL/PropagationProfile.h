@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace PROPOSAL {
+
+/*!
+ * Wall time and number of calls of the phases of the propagation loop.
+ *
+ * The phases are only timed if PROPOSAL has been built with the CMake option
+ * PROPOSAL_PROFILING, otherwise all timers are compiled out and the profile
+ * stays empty. Timings are collected per thread and added to the profile of
+ * the propagator after every propagation.
+ */
+struct PropagationProfile {
+    enum Phase : size_t {
+        EnergyInteraction,
+        EnergyDecay,
+        LengthContinuous,
+        EnergyDistance,
+        DensityCorrect,
+        DirectionsScatter,
+        DistanceToBorder,
+        StochasticInteraction,
+        EnergyRandomize,
+        NumberOfPhases,
+    };
+
+    size_t propagations = 0;
+    double total_seconds = 0.; //!< wall time of all propagations
+    std::array<size_t, NumberOfPhases> calls = {};
+    std::array<double, NumberOfPhases> seconds = {};
+
+    static const char* GetPhaseName(size_t phase);
+
+    /*!
+     * True if the timers have been compiled in.
+     */
+    static bool IsEnabled();
+
+    /*!
+     * Timings of the calling thread, which are collected by the timers.
+     */
+    static PropagationProfile& ThisThread();
+
+    PropagationProfile& operator+=(const PropagationProfile&);
+    PropagationProfile& operator-=(const PropagationProfile&);
+    friend std::ostream& operator<<(std::ostream&, const PropagationProfile&);
+};
+
+/*!
+ * Adds the wall time of its lifetime to a phase of the profile of the
+ * calling thread.
+ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(PropagationProfile::Phase phase)
+        : phase_(phase)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+    ~PhaseTimer()
+    {
+        auto& profile = PropagationProfile::ThisThread();
+        profile.calls[phase_]++;
+        profile.seconds[phase_] += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    PropagationProfile::Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace PROPOSAL
+
+#ifdef PROPOSAL_PROFILING
+#define PROPOSAL_PROFILE_PHASE(phase)                                          \
+    PROPOSAL::PhaseTimer proposal_phase_timer_(                                \
+        PROPOSAL::PropagationProfile::phase)
+#else
+#define PROPOSAL_PROFILE_PHASE(phase)
+#endif
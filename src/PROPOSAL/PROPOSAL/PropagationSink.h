@@ -0,0 +1,89 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "PROPOSAL/particle/Particle.h"
+
+namespace PROPOSAL {
+
+class Geometry;
+
+/*!
+ * Receiver for the events of a single propagation. Passing a sink to
+ * Propagator::Propagate reports every step inline instead of storing it in
+ * a Secondaries object, so consumers which reduce a track to a few numbers do
+ * not have to build and walk the full track. All callbacks do nothing by
+ * default, derived classes override the ones they are interested in.
+ */
+class PropagationSink {
+public:
+    virtual ~PropagationSink() = default;
+
+    /*!
+     * Called with the initial state and with the particle state after every
+     * continuous step.
+     */
+    virtual void OnContinuousStep(const ParticleState&) {}
+
+    /*!
+     * Called after a stochastic loss.
+     * @param state particle state after the loss
+     * @param type type of the interaction
+     * @param energy_loss energy lost in the interaction in MeV
+     * @param target_hash hash of the component the interaction occurred with
+     */
+    virtual void OnStochasticLoss(const ParticleState& state,
+        InteractionType type, double energy_loss, size_t target_hash)
+    {
+        (void)state;
+        (void)type;
+        (void)energy_loss;
+        (void)target_hash;
+    }
+
+    /*!
+     * Called when the particle leaves the geometry of one sector and enters
+     * the one of another sector.
+     */
+    virtual void OnBorderCrossing(const ParticleState& state,
+        const Geometry& geometry_left, const Geometry& geometry_entered)
+    {
+        (void)state;
+        (void)geometry_left;
+        (void)geometry_entered;
+    }
+
+    /*!
+     * Called with the state of the particle when it decays.
+     */
+    virtual void OnDecay(const ParticleState&) {}
+};
+
+} // namespace PROPOSAL
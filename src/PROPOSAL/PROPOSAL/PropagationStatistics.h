@@ -0,0 +1,125 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+
+namespace PROPOSAL {
+
+/*!
+ * Counters of the hot path of the propagation. They describe how hard the
+ * propagator had to work to find valid steps and how often numerical
+ * fallbacks have been used, which makes slow configurations and geometries
+ * visible without parsing log output.
+ */
+struct PropagationStatistics {
+    size_t propagations = 0; //!< number of propagated particles
+    size_t advance_particle_calls = 0; //!< number of continuous steps
+    size_t advance_particle_iterations = 0; //!< iterations in all steps
+    size_t advance_particle_max_iterations = 0; //!< iterations of the
+                                                //!< longest step
+    size_t invalid_steps = 0; //!< rejected step proposals
+    size_t backscatter_resamples = 0; //!< random numbers redrawn after
+                                      //!< scattering back into a sector
+    size_t unreachable_step_resamples = 0; //!< random numbers redrawn because
+                                           //!< the proposed distance was not
+                                           //!< reachable before the next
+                                           //!< interaction
+    size_t max_steps_reached = 0; //!< steps aborted after
+                                  //!< ADVANCE_PARTICLE_MAX_STEPS iterations
+    size_t density_exception_fallbacks = 0; //!< DensityExceptions caught
+    size_t utility_bisection_fallbacks = 0; //!< failed Newton-Raphson
+                                            //!< iterations in
+                                            //!< UtilityInterpolant
+    size_t dndx_bisection_fallbacks = 0; //!< failed Newton-Raphson iterations
+                                         //!< in CrossSectionDNDXInterpolant
+
+    PropagationStatistics& operator+=(const PropagationStatistics&);
+    friend std::ostream& operator<<(
+        std::ostream&, const PropagationStatistics&);
+};
+
+/*!
+ * Numerical fallbacks of the interpolants, counted per thread. The
+ * interpolants are shared between propagators and threads, so the propagator
+ * attributes the fallbacks to itself by comparing the counters of the
+ * propagating thread before and after a propagation.
+ */
+struct InterpolantFallbacks {
+    size_t utility_bisection = 0;
+    size_t dndx_bisection = 0;
+
+    static InterpolantFallbacks& ThisThread();
+};
+
+/*!
+ * Thread-safe sum of the counters of several propagations. T has to be
+ * default constructible and provide operator+=. Copies take over the current
+ * values, but not the lock.
+ */
+template <typename T> class Accumulator {
+public:
+    Accumulator() = default;
+    Accumulator(const Accumulator& other)
+        : value_(other.Get())
+    {
+    }
+    Accumulator& operator=(const Accumulator& other)
+    {
+        if (this != &other) {
+            auto value = other.Get();
+            std::lock_guard<std::mutex> lock(mutex_);
+            value_ = value;
+        }
+        return *this;
+    }
+
+    void Add(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        value_ += value;
+    }
+    T Get() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return value_;
+    }
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        value_ = T();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    T value_;
+};
+
+} // namespace PROPOSAL
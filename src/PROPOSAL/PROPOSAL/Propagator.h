@@ -1,7 +1,12 @@
 #pragma once
 
+#include "PROPOSAL/PropagationProfile.h"
+#include "PROPOSAL/PropagationSink.h"
+#include "PROPOSAL/PropagationStatistics.h"
 #include "PROPOSAL/Secondaries.h"
+#include "PROPOSAL/SectorList.h"
 #include <nlohmann/json.hpp>
+#include <random>
 #include <unordered_map>
 
 namespace PROPOSAL {
@@ -13,6 +18,19 @@ using Sector = std::tuple<std::shared_ptr<const Geometry>, PropagationUtility,
     std::shared_ptr<const Density_distr>>;
 
 struct CrossSectionBase;
+
+/*!
+ * Selects which particle states are stored in the Secondaries returned by
+ * Propagator::Propagate. Reduced modes save memory, but only the stored
+ * states are available for the analysis methods of Secondaries.
+ */
+enum class TrackRecording : int {
+    Full, //!< every continuous step, stochastic loss and decay
+    StochasticLosses, //!< initial and final state, every stochastic loss
+                      //!< together with the state directly before it, and
+                      //!< the decay
+    Endpoints, //!< initial and final (or decay) state only
+};
 }
 
 namespace PROPOSAL {
@@ -28,20 +46,100 @@ public:
     Secondaries Propagate(const ParticleState& initial_particle,
         double max_distance = 1e20, double min_energy = 0.,
         unsigned int hierarchy_condition = 0);
+
+    /*!
+     * Propagate a particle, drawing all random numbers from the given engine
+     * instead of the global RandomGenerator. The propagator itself is not
+     * modified during propagation, so the same instance can be used from
+     * several threads at once as long as every thread owns its engine.
+     */
+    Secondaries Propagate(const ParticleState& initial_particle,
+        std::mt19937& rng, double max_distance = 1e20,
+        double min_energy = 0., unsigned int hierarchy_condition = 0);
+
+    /*!
+     * Propagate a particle into a caller provided Secondaries object. The
+     * object is reset first, but keeps its allocated memory, so reusing the
+     * same output object for many events avoids reallocations of the track.
+     */
+    void Propagate(const ParticleState& initial_particle, Secondaries& out,
+        double max_distance = 1e20, double min_energy = 0.,
+        unsigned int hierarchy_condition = 0);
+    void Propagate(const ParticleState& initial_particle, Secondaries& out,
+        std::mt19937& rng, double max_distance = 1e20,
+        double min_energy = 0., unsigned int hierarchy_condition = 0);
+
+    /*!
+     * Propagate a particle and report every step to the given sink instead
+     * of recording it in a Secondaries object.
+     */
+    void Propagate(const ParticleState& initial_particle, PropagationSink& sink,
+        double max_distance = 1e20, double min_energy = 0.,
+        unsigned int hierarchy_condition = 0);
+    void Propagate(const ParticleState& initial_particle, PropagationSink& sink,
+        std::mt19937& rng, double max_distance = 1e20,
+        double min_energy = 0., unsigned int hierarchy_condition = 0);
+
+    /*!
+     * Propagate a batch of particles with a pool of worker threads. Workers
+     * pull the next unprocessed event as soon as they are finished, so short
+     * and long tracks are balanced automatically. Every event uses its own
+     * random engine seeded with (seed, event index), so the results only
+     * depend on the seed and not on the number of threads.
+     * @param initial_particles Initial states of the particles to propagate
+     * @param seed Seed from which the per event random streams are derived
+     * @param n_threads Number of worker threads. If zero, the number of
+     * hardware threads is used.
+     * @return Secondaries of every event, in the order of initial_particles
+     */
+    std::vector<Secondaries> PropagateBatch(
+        const std::vector<ParticleState>& initial_particles, unsigned int seed,
+        unsigned int n_threads = 0, double max_distance = 1e20,
+        double min_energy = 0., unsigned int hierarchy_condition = 0);
     enum { GEOMETRY, UTILITY, DENSITY_DISTR };
 
+    /*!
+     * Set which states are stored in the Secondaries returned by Propagate
+     * and PropagateBatch. Propagating into a PropagationSink always reports
+     * every step.
+     */
+    void SetTrackRecording(TrackRecording mode) { track_recording = mode; }
+    TrackRecording GetTrackRecording() const { return track_recording; }
+
+    /*!
+     * Enable or disable the collection of hot path statistics. If enabled,
+     * the counters of every propagation are added to the statistics of the
+     * propagator, which can be queried with GetStatistics().
+     */
+    void SetCollectStatistics(bool collect) { collect_statistics = collect; }
+    bool GetCollectStatistics() const { return collect_statistics; }
+    PropagationStatistics GetStatistics() const { return statistics.Get(); }
+    void ResetStatistics() { statistics.Reset(); }
+
+    /*!
+     * Wall time and calls of the phases of all propagations since the last
+     * reset. Only available if PROPOSAL has been built with the CMake option
+     * PROPOSAL_PROFILING, see PropagationProfile.
+     */
+    PropagationProfile GetProfile() const { return profile.Get(); }
+    void ResetProfile() { profile.Reset(); }
+
 private:
+    void DoPropagation(const ParticleState& initial_particle,
+        PropagationSink& sink, std::function<double()> rnd,
+        double max_distance, double min_energy,
+        unsigned int hierarchy_condition);
     Interaction::Loss DoStochasticInteraction(
-        ParticleState&, PropagationUtility&, std::function<double()>);
+        ParticleState&, const PropagationUtility&, std::function<double()>);
     int AdvanceParticle(ParticleState& p_cond, const double E_f,
                         const double max_distance, std::function<double()> rnd,
-                        Sector& current_sector, bool min_energy_step,
-                        const double min_energy);
+                        const Sector*& current_sector, bool min_energy_step,
+                        const double min_energy, PropagationStatistics& stats);
     double CalculateDistanceToBorder(const Vector3D& particle_position,
         const Vector3D& particle_direction, const Geometry& current_geometry);
     int maximize(const std::array<double, 3>& InteractionEnergies);
     int minimize(const std::array<double, 3>& AdvanceDistances);
-    Sector GetCurrentSector(
+    const Sector& GetCurrentSector(
         const Vector3D& particle_position, const Vector3D& particle_direction);
     // Global settings
     struct GlobalSettings {
@@ -57,8 +155,8 @@ private:
 
     // Initializing methods
     static nlohmann::json ParseConfig(const std::string& config_file);
-    void InitializeSectorFromJSON(
-        const ParticleDef&, const nlohmann::json&, GlobalSettings);
+    void InitializeSectorFromJSON(const ParticleDef&, const nlohmann::json&,
+        GlobalSettings, std::vector<Sector>&);
 
     PropagationUtility::Collection CreateUtility(
         std::vector<std::shared_ptr<CrossSectionBase>> crosss,
@@ -70,7 +168,7 @@ private:
         std::shared_ptr<const EnergyCutSettings> cuts, bool interpolate,
         double density_correction, const nlohmann::json& config);
 
-    ParticleDef p_def;
+    std::shared_ptr<ParticleDef> p_def;
     enum Type : int {
         Decay = 0,
         MinimalE = 1,
@@ -83,7 +181,11 @@ private:
         ReachedBorder = 3
     };
 
-    std::vector<Sector> sector_list;
+    std::shared_ptr<const SectorList> sector_list;
+    TrackRecording track_recording = TrackRecording::Full;
+    bool collect_statistics = false;
+    Accumulator<PropagationStatistics> statistics;
+    Accumulator<PropagationProfile> profile;
 };
 
 } // namespace PROPOSAL
@@ -27,10 +27,13 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "PROPOSAL/SectorList.h"
 #include "PROPOSAL/particle/Particle.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
@@ -41,8 +44,32 @@ class Density_distr;
 class Geometry;
 class Vector3D;
 
-using Sector = std::tuple<std::shared_ptr<const Geometry>, PropagationUtility,
-            std::shared_ptr<const Density_distr>>;
+/*!
+ * Read-only view on a contiguous column of values owned by another object. It
+ * does not copy the values and is only valid as long as the owner is alive
+ * and unmodified.
+ */
+template <typename T> class ColumnView {
+public:
+    ColumnView(const T* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& front() const { return data_[0]; }
+    const T& back() const { return data_[size_ - 1]; }
+    const T& operator[](size_t idx) const { return data_[idx]; }
+
+private:
+    const T* data_;
+    size_t size_;
+};
 
 class Secondaries {
 
@@ -53,12 +80,17 @@ public:
      * interactions during the propagation.
      *
      * For this, it stores all intermediate particle states during propagation
-     * in a track object, which is a list of ParticleState objects.
+     * in a track object. The track is stored column-wise, i.e. every quantity
+     * of the particle states is kept in a separate contiguous list, which can
+     * be accessed without copies via the Get...Column() methods.
      * @param p_def ParticleDef describing the physics of the propagated
      * particle
-     * @param sectors List of sectors of the original propagator. This is
-     * needed if particle have to be re-propagated.
+     * @param sectors Sectors of the original propagator. This is needed if
+     * particle have to be re-propagated. The list is shared with the
+     * propagator and not copied.
      */
+    Secondaries(std::shared_ptr<ParticleDef> p_def,
+        std::shared_ptr<const SectorList> sectors);
     Secondaries(std::shared_ptr<ParticleDef> p_def, std::vector<Sector> sectors);
 
     // Particle state functions
@@ -68,14 +100,14 @@ public:
      * @return ParticleState object, describing the particle at the beginning
      * of the propagation
      */
-    ParticleState GetInitialState() const { return track_.front(); }
+    ParticleState GetInitialState() const { return GetState(0); }
 
     /*!
      * Get information on the final state of the propagated particle
      * @return ParticleState object, describing the particle after the
      * propagation
      */
-    ParticleState GetFinalState() const { return track_.back(); }
+    ParticleState GetFinalState() const { return GetState(size() - 1); }
 
     /*!
      * Get information on the state of the propagated particle when it has
@@ -210,6 +242,14 @@ public:
      */
     std::vector<ParticleState> GetDecayProducts() const;
 
+    /*!
+     * Same as GetDecayProducts(), but all random numbers are drawn from the
+     * given engine instead of the global RandomGenerator.
+     * @param rng Random engine owned by the caller
+     * @return List of ParticleStates, describing the decay products.
+     */
+    std::vector<ParticleState> GetDecayProducts(std::mt19937& rng) const;
+
     // Loss functions
 
     /*!
@@ -272,7 +312,7 @@ public:
      * @return List of ParticleState objects describing the states of the
      * particle during propagation.
      */
-    std::vector<ParticleState> GetTrack() const { return track_; };
+    std::vector<ParticleState> GetTrack() const;
 
     /*!
      * Returns the particle track, but only the particle states of the
@@ -372,19 +412,49 @@ public:
      * stored in this Secondaries class.
      * @return unsigned int which describes the length of the track object.
      */
-    unsigned int GetTrackLength() const { return track_.size(); };
+    unsigned int GetTrackLength() const { return size(); };
+
+    // Column access
+
+    /*!
+     * Read-only views on the columns of the track. The i-th element of every
+     * column belongs to the i-th particle state of the track. No values are
+     * copied, so the views are only valid as long as this object is alive and
+     * not modified.
+     */
+    ColumnView<double> GetEnergyColumn() const { return View(energy_); }
+    ColumnView<double> GetTimeColumn() const { return View(time_); }
+    ColumnView<double> GetPropagatedDistanceColumn() const { return View(distance_); }
+    ColumnView<double> GetXColumn() const { return View(x_); }
+    ColumnView<double> GetYColumn() const { return View(y_); }
+    ColumnView<double> GetZColumn() const { return View(z_); }
+    ColumnView<double> GetDirectionXColumn() const { return View(dx_); }
+    ColumnView<double> GetDirectionYColumn() const { return View(dy_); }
+    ColumnView<double> GetDirectionZColumn() const { return View(dz_); }
+    ColumnView<int> GetParticleTypeColumn() const { return View(particle_types_); }
+    ColumnView<InteractionType> GetTypeColumn() const { return View(types_); }
+    ColumnView<size_t> GetTargetHashColumn() const { return View(target_hashes_); }
 
     // Operational functions to fill and access track
+    size_t size() const { return energy_.size(); }
     void reserve(size_t number_secondaries);
-    void clear() { track_.clear(); types_.clear(); target_hashes_.clear(); };
+    void clear();
+
+    /*!
+     * Remove all states and attach the object to the given particle and
+     * sectors. The allocated memory of the track is kept, so the object can
+     * be reused as output of many propagations.
+     */
+    void reset(std::shared_ptr<ParticleDef> p_def,
+        std::shared_ptr<const SectorList> sectors);
     void push_back(const ParticleState& point, const InteractionType& type,
                    const size_t& target_hash = 0);
     void emplace_back(const ParticleType& particle_type, const Vector3D& position,
                       const Vector3D& direction, const double& energy, const double& time,
                       const double& distance, const InteractionType& interaction_type,
                       const size_t& target_hash = 0);
-    const ParticleState& back() const {return track_.back(); }
-    const ParticleState& operator[](std::size_t idx) { return track_[idx]; };
+    ParticleState back() const { return GetState(size() - 1); }
+    ParticleState operator[](std::size_t idx) const { return GetState(idx); };
 
 private:
     ParticleState RePropagateDistance(const ParticleState& init_state,
@@ -394,14 +464,31 @@ private:
                                     const Cartesian3D& direction,
                                     double energy_lost,
                                     double max_distance) const;
-    Sector GetCurrentSector(const Vector3D& position,
-                            const Vector3D& direction) const;
-
-    std::vector<ParticleState> track_;
+    const Sector& GetCurrentSector(const Vector3D& position,
+                                   const Vector3D& direction) const;
+    std::vector<ParticleState> DoDecay(std::function<double()> rnd) const;
+
+    ParticleState GetState(size_t idx) const;
+    Cartesian3D GetPosition(size_t idx) const;
+    Cartesian3D GetDirection(size_t idx) const;
+    bool IsStochasticLoss(size_t idx) const;
+
+    template <typename T>
+    static ColumnView<T> View(const std::vector<T>& column)
+    {
+        return ColumnView<T>(column.data(), column.size());
+    }
+
+    std::vector<double> energy_;
+    std::vector<double> time_;
+    std::vector<double> distance_;
+    std::vector<double> x_, y_, z_;
+    std::vector<double> dx_, dy_, dz_;
+    std::vector<int> particle_types_;
     std::vector<InteractionType> types_;
     std::vector<size_t> target_hashes_;
     std::shared_ptr<ParticleDef> primary_def_;
-    std::vector<Sector> sectors_;
+    std::shared_ptr<const SectorList> sectors_;
 };
 
 } // namespace PROPOSAL
@@ -0,0 +1,78 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/propagation_utility/PropagationUtility.h"
+
+namespace PROPOSAL {
+
+class Density_distr;
+class Geometry;
+class Vector3D;
+
+using Sector = std::tuple<std::shared_ptr<const Geometry>, PropagationUtility,
+            std::shared_ptr<const Density_distr>>;
+
+/*!
+ * Immutable list of the sectors of a propagator, together with a spatial
+ * index over their geometries. A single instance is owned by the Propagator
+ * and shared with every Secondaries object it creates, so that tracks can
+ * re-propagate inside the sectors without copying them.
+ */
+class SectorList {
+public:
+    SectorList(std::vector<Sector> sectors);
+
+    /*!
+     * Sector with the highest hierarchy containing the given position.
+     * Throws std::out_of_range if no sector is defined at the position.
+     */
+    const Sector& GetCurrentSector(
+        const Vector3D& position, const Vector3D& direction) const;
+
+    /*!
+     * Distance to the border of the given geometry or of any sector geometry
+     * with a higher hierarchy, whichever is crossed first.
+     */
+    double DistanceToBorder(const Vector3D& position,
+        const Vector3D& direction, const Geometry& current_geometry) const;
+
+    const std::vector<Sector>& GetSectors() const { return sectors_; }
+    size_t size() const { return sectors_.size(); }
+
+private:
+    std::vector<Sector> sectors_;
+    BoundingVolumeHierarchy index_;
+};
+
+} // namespace PROPOSAL
@@ -38,8 +38,9 @@
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <vector>
 
 namespace PROPOSAL {
@@ -56,6 +57,18 @@ struct CrossSectionBase {
         double)
         = 0;
     virtual double CalculateStochasticLoss(size_t, double, double) = 0;
+
+    /*!
+     * The components of the medium a stochastic loss can occur on. They are
+     * addressed by a fixed index below GetNumComponents(), which is also the
+     * position of the component in CalculatedNdx_PerTarget.
+     */
+    virtual size_t GetNumComponents() const noexcept = 0;
+    virtual size_t GetComponentHash(size_t index) const = 0;
+    virtual double CalculatedNdx_ByIndex(double, size_t index) = 0;
+    virtual double CalculateStochasticLoss_ByIndex(size_t index, double, double)
+        = 0;
+
     virtual double GetLowerEnergyLim() const = 0;
     virtual size_t GetHash() const noexcept = 0;
     virtual InteractionType GetInteractionType() const noexcept = 0;
@@ -75,15 +88,15 @@ namespace detail {
         size_t hash = 0)
     {
         using dndx_ptr_t = std::unique_ptr<CrossSectionDNDX>;
-        using dndx_map_t
-            = std::unordered_map<size_t, std::tuple<double, dndx_ptr_t>>;
+        using dndx_container
+            = std::vector<std::tuple<double, dndx_ptr_t, size_t>>;
         if (cut)
             if (cut->GetEcut() == INF && cut->GetVcut() == 1)
-                return std::unique_ptr<dndx_map_t>();
+                return std::unique_ptr<dndx_container>();
         auto calc = make_dndx(interpol, param, p, m, cut, hash);
-        auto dndx_map = std::make_unique<dndx_map_t>();
-        dndx_map->emplace(m.GetHash(), std::make_tuple(1., std::move(calc)));
-        return dndx_map;
+        auto dndx = std::make_unique<dndx_container>();
+        dndx->emplace_back(1., std::move(calc), m.GetHash());
+        return dndx;
     }
 
     template <typename Param>
@@ -92,21 +105,25 @@ namespace detail {
         size_t hash = 0)
     {
         using dndx_ptr_t = std::unique_ptr<CrossSectionDNDX>;
-        using dndx_map_t
-            = std::unordered_map<size_t, std::tuple<double, dndx_ptr_t>>;
+        using dndx_container
+            = std::vector<std::tuple<double, dndx_ptr_t, size_t>>;
         if (cut) // TODO: is this branch realy necessary, why is a dndx created
                  // for these settings?
             if (cut->GetEcut() == INF && cut->GetVcut() == 1)
-                return std::unique_ptr<dndx_map_t>();
-        auto dndx_map = std::make_unique<dndx_map_t>();
-        for (auto& c : m.GetComponents()) {
-            auto comp_hash = c.GetHash();
-            auto weight = weight_component(m, c);
-            auto calc = make_dndx(interpol, param, p, c, cut, hash);
-            dndx_map->emplace(
-                comp_hash, std::make_tuple(weight, std::move(calc)));
+                return std::unique_ptr<dndx_container>();
+        // the tables of the components are independent and built concurrently
+        auto components = m.GetComponents();
+        auto calcs = std::vector<dndx_ptr_t>(components.size());
+        Helper::ParallelFor(components.size(), [&](size_t i) {
+            calcs[i] = make_dndx(interpol, param, p, components[i], cut, hash);
+        });
+        auto dndx = std::make_unique<dndx_container>();
+        for (size_t i = 0; i < components.size(); ++i) {
+            auto& c = components[i];
+            dndx->emplace_back(
+                weight_component(m, c), std::move(calcs[i]), c.GetHash());
         }
-        return dndx_map;
+        return dndx;
     }
 
     template <typename Cont, typename T1, typename T2, typename T3,
@@ -223,8 +240,8 @@ protected:
     size_t hash;
     std::shared_ptr<spdlog::logger> logger;
 
-    std::unique_ptr<std::unordered_map<size_t, std::tuple<double, dndx_ptr>>>
-        dndx;
+    // weight, calculator and hash of each component, addressed by its index
+    std::unique_ptr<std::vector<std::tuple<double, dndx_ptr, size_t>>> dndx;
     std::unique_ptr<std::vector<std::tuple<double, dedx_ptr>>> dedx;
     std::unique_ptr<std::vector<std::tuple<double, de2dx_ptr>>> de2dx;
 
@@ -258,7 +275,7 @@ public:
         hash = 0;
         if (dndx) {
             for (auto& dndx_: *dndx)
-                hash_combine(hash, std::get<1>(dndx_.second)->GetHash());
+                hash_combine(hash, std::get<1>(dndx_)->GetHash());
         }
         if (dedx) {
             for (auto& dedx_: *dedx)
@@ -273,11 +290,22 @@ public:
     virtual ~CrossSection() = default;
 
 protected:
+    size_t GetComponentIndex(size_t comp_hash) const
+    {
+        if (dndx)
+            for (size_t i = 0; i < dndx->size(); ++i)
+                if (std::get<2>((*dndx)[i]) == comp_hash)
+                    return i;
+        throw std::out_of_range("Component with hash "
+            + std::to_string(comp_hash)
+            + " is not a target of the crosssection.");
+    }
+
     double CalculateStochasticLoss_impl(
-        size_t target_hash, double E, double rate, std::false_type)
+        size_t index, double E, double rate, std::false_type)
     {
-        return std::get<1>((*dndx)[target_hash])
-            ->GetUpperLimit(E, rate * std::get<0>((*dndx)[target_hash]));
+        auto& comp = (*dndx)[index];
+        return std::get<1>(comp)->GetUpperLimit(E, rate * std::get<0>(comp));
     }
 
     double CalculateStochasticLoss_impl(size_t, double, double, std::true_type)
@@ -290,27 +318,25 @@ public:
     {
         auto dNdx_all = 0.;
         if (dndx)
-            for (auto& it : *dndx) {
-                dNdx_all += std::get<1>((*dndx)[it.first])->Calculate(E)
-                    / std::get<0>((*dndx)[it.first]);
-            }
+            for (auto& comp : *dndx)
+                dNdx_all += std::get<1>(comp)->Calculate(E) / std::get<0>(comp);
         return dNdx_all;
     };
 
     double CalculatedNdx(double E, size_t target_hash) override
     {
         if (dndx)
-            return std::get<1>((*dndx)[target_hash])->Calculate(E)
-                / std::get<0>((*dndx)[target_hash]);
+            return CalculatedNdx_ByIndex(E, GetComponentIndex(target_hash));
         return 0.;
     };
 
     double CalculateCumulativeCrosssection(
         double E, size_t hash, double v) override
     {
-        if (dndx)
-            return std::get<1>((*dndx)[hash])->Calculate(E, v)
-                / std::get<0>((*dndx)[hash]);
+        if (dndx) {
+            auto& comp = (*dndx)[GetComponentIndex(hash)];
+            return std::get<1>(comp)->Calculate(E, v) / std::get<0>(comp);
+        }
         return 0.;
     }
 
@@ -319,17 +345,41 @@ public:
     {
         std::vector<std::pair<size_t, double>> rates = {};
         if (dndx) {
-            for (auto& c : *dndx)
-                rates.push_back({ c.first, CalculatedNdx(E, c.first) });
+            for (size_t i = 0; i < dndx->size(); ++i)
+                rates.push_back(
+                    { std::get<2>((*dndx)[i]), CalculatedNdx_ByIndex(E, i) });
         }
         return rates;
     }
 
     double CalculateStochasticLoss(size_t hash, double E, double rate) override
+    {
+        return CalculateStochasticLoss_ByIndex(
+            dndx ? GetComponentIndex(hash) : 0, E, rate);
+    }
+
+    size_t GetNumComponents() const noexcept override
+    {
+        return dndx ? dndx->size() : 0;
+    }
+
+    size_t GetComponentHash(size_t index) const override
+    {
+        return std::get<2>(dndx->at(index));
+    }
+
+    double CalculatedNdx_ByIndex(double E, size_t index) override
+    {
+        auto& comp = (*dndx)[index];
+        return std::get<1>(comp)->Calculate(E) / std::get<0>(comp);
+    }
+
+    double CalculateStochasticLoss_ByIndex(
+        size_t index, double E, double rate) override
     {
         if (dndx)
             return CalculateStochasticLoss_impl(
-                hash, E, rate, only_stochastic {});
+                index, E, rate, only_stochastic {});
         throw std::logic_error("Can not calculate stochastic loss if dndx "
                                "calculator is not defined. The crosssection "
                                "is probably defined to be only-continuous.");
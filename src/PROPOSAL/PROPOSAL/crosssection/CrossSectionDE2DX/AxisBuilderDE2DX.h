@@ -17,5 +17,9 @@ namespace PROPOSAL {
                 std::function<double(double)> func, unsigned int i = 0);
 
         std::unique_ptr<cubic_splines::ExpAxis<double>> Create() const;
+
+        double GetLow() const { return low; }
+        double GetUp() const { return up; }
+        size_t GetNodes() const { return n; }
     };
 } // namespace PROPOSAL
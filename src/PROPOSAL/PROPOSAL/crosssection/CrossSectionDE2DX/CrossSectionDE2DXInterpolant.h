@@ -3,6 +3,7 @@
 
 #include "PROPOSAL/crosssection/CrossSectionDE2DX/CrossSectionDE2DXIntegral.h"
 #include "PROPOSAL/crosssection/CrossSectionDE2DX/AxisBuilderDE2DX.h"
+#include "PROPOSAL/math/SegmentedTable.h"
 
 #include <type_traits>
 
@@ -11,37 +12,29 @@
 
 namespace PROPOSAL {
 
-template <typename T1, typename T2, typename... Args>
-auto build_de2dx_def(T1 const& param, T2 const& p_def, Args... args)
-{
-    auto de2dx
-        = std::make_shared<CrossSectionDE2DXIntegral>(param, p_def, args...);
-    auto ax = AxisBuilderDE2DX(param.GetLowerEnergyLim(p_def));
-    ax.refine_definition_range([de2dx](double E) { return de2dx->Calculate(E); });
-
-    auto def = cubic_splines::CubicSplines<double>::Definition();
-    def.f = [de2dx](double E) { return de2dx->Calculate(E); };
-    def.f_trafo = std::make_unique<cubic_splines::ExpAxis<double>>(1., 0.);
-    def.axis = ax.Create();
-    return def;
-}
-
 class CrossSectionDE2DXInterpolant : public CrossSectionDE2DX {
 
-    cubic_splines::Interpolant<cubic_splines::CubicSplines<double>> interpolant;
+    using interpolant_t
+        = cubic_splines::Interpolant<cubic_splines::CubicSplines<double>>;
+    using table_t = SegmentedTable<std::shared_ptr<const interpolant_t>>;
 
-    std::string gen_name() const;
-    std::string gen_path() const;
+    std::string gen_name(size_t hash) const;
     size_t gen_hash(size_t) const;
+    table_t build_table(
+        std::shared_ptr<CrossSectionDE2DXIntegral>, double lower_lim) const;
+
+    table_t interpolant;
 
 public:
     template <typename Param, typename Target>
     CrossSectionDE2DXInterpolant(Param const& param, ParticleDef const& p,
         Target const& t, EnergyCutSettings const& cut, size_t hash = 0)
         : CrossSectionDE2DX(param, p, t, cut, gen_hash(hash))
-        , interpolant(build_de2dx_def(param, p, t, cut), gen_path(), gen_name())
+        , interpolant(build_table(
+              std::make_shared<CrossSectionDE2DXIntegral>(param, p, t, cut),
+              param.GetLowerEnergyLim(p)))
     {
-            lower_energy_lim = interpolant.GetDefinition().GetAxis().GetLow();
+            lower_energy_lim = interpolant.GetLow();
     }
 
     double Calculate(double E) const final;
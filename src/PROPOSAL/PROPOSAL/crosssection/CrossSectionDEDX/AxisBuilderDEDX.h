@@ -21,6 +21,10 @@ public:
         std::function<double(double)> func, unsigned int i = 0);
 
     std::unique_ptr<cubic_splines::ExpAxis<double>> Create() const;
+
+    double GetLow() const { return low; }
+    double GetUp() const { return up; }
+    size_t GetNodes() const { return n; }
 };
 
 static constexpr auto axis_builder_dedx_err_str
@@ -3,9 +3,10 @@
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/crosssection/CrossSectionDNDX/AxisBuilderDNDX.h"
 #include "PROPOSAL/crosssection/CrossSectionDNDX/CrossSectionDNDXIntegral.h"
-#include "PROPOSAL/methods.h"
+#include "PROPOSAL/math/SegmentedTable.h"
 
 #include <type_traits>
+#include <utility>
 
 #include "CubicInterpolation/BicubicSplines.h"
 #include "CubicInterpolation/Interpolant.h"
@@ -59,40 +60,58 @@ double retransform_loss(double v_cut, double v_max, double v) {
     return retransform_loss_log(v_cut, v_max, v);
 }
 
+namespace detail {
+    // Returns f, but evaluates it at all nodes of the two axes concurrently
+    // as soon as the value at the first node is requested. The values at the
+    // nodes are taken from these results afterwards.
+    std::function<double(double, double)> evaluate_nodes_concurrently(
+        cubic_splines::Axis<double> const&, cubic_splines::Axis<double> const&,
+        std::function<double(double, double)> f);
+} // namespace detail
+
+// dNdx integral and the function tabulated by the interpolant, which is dNdx
+// in terms of the transformed relative energy loss
 template <typename T1, typename... Args>
-auto build_dndx_def(T1 const& param, ParticleDef const& p, Args... args)
+auto build_dndx_integrand(T1 const& param, ParticleDef const& p, Args... args)
 {
     auto dndx = std::make_shared<CrossSectionDNDXIntegral>(param, p, args...);
-    auto v_lim = AxisBuilderDNDX::v_limits { 0, 1,
-        InterpolationSettings::NODES_DNDX_V };
-    auto energy_lim = AxisBuilderDNDX::energy_limits();
-    energy_lim.low = param.GetLowerEnergyLim(p);
-    energy_lim.up = InterpolationSettings::UPPER_ENERGY_LIM;
-    energy_lim.nodes = InterpolationSettings::NODES_DNDX_E ;
-    auto energy_lim_refined = AxisBuilderDNDX::refine_definition_range(energy_lim,
-        [dndx](double E) { return dndx->Calculate(E); });
-
-    auto def = cubic_splines::BicubicSplines<double>::Definition();
-    def.axis = AxisBuilderDNDX::Create(v_lim, energy_lim_refined);
-    def.f = [dndx](double energy, double v) {
+    auto f = [dndx](double energy, double v) {
         auto lim = dndx->GetIntegrationLimits(energy);
         v = transform_loss<T1>(lim.min, lim.max, v);
         return dndx->Calculate(energy, v);
     };
-    def.approx_derivates = true;
-    return def;
+    return std::make_pair(dndx, std::function<double(double, double)>(f));
 }
 
-class CrossSectionDNDXInterpolant : public CrossSectionDNDX, public LogTableCreation {
+class CrossSectionDNDXInterpolant : public CrossSectionDNDX {
+    using interpolant_t
+        = cubic_splines::Interpolant<cubic_splines::BicubicSplines<double>>;
+
+    /*!
+     * dNdx(E, vbar) of a segment and, if
+     * InterpolationSettings::DNDX_INVERSE_TABLES is set, its inverse
+     * vbar(E, dNdx(E, vbar) / dNdx(E, 1)). The inverse is only accurate to
+     * about a percent, so it gives the initial guess from which vbar is
+     * solved within one or two newton raphson steps.
+     */
+    struct Tables {
+        std::shared_ptr<const interpolant_t> dndx;
+        std::shared_ptr<const interpolant_t> inverse;
+    };
+    using table_t = SegmentedTable<Tables>;
+    using integrand_t = std::pair<std::shared_ptr<CrossSectionDNDXIntegral>,
+        std::function<double(double, double)>>;
+
     std::function<double(double, double, double)> transform_v;
     std::function<double(double, double, double)> retransform_v;
-    cubic_splines::Interpolant<cubic_splines::BicubicSplines<double>>
-        interpolant;
+    table_t interpolant;
     InteractionType type_id;
 
     std::string gen_path() const;
-    std::string gen_name() const;
+    std::string gen_name(size_t hash) const;
+    std::string gen_inverse_name(size_t hash) const;
     size_t gen_hash(size_t) const;
+    table_t build_table(integrand_t, double lower_lim) const;
     double evaluate_interpolant(double E, double vbar);
 
 public:
@@ -100,15 +119,15 @@ public:
     CrossSectionDNDXInterpolant(Param param, ParticleDef const& p,
         Target const& t, std::shared_ptr<const EnergyCutSettings> cut,
         size_t hash = 0)
-        : CrossSectionDNDX(param, p, t, cut, gen_hash(hash)), LogTableCreation(gen_path(), gen_name())
+        : CrossSectionDNDX(param, p, t, cut, gen_hash(hash))
         , transform_v(transform_loss<Param>)
         , retransform_v(retransform_loss<Param>)
-        , interpolant(build_dndx_def(param, p, t, cut), gen_path(), gen_name())
+        , interpolant(build_table(build_dndx_integrand(param, p, t, cut),
+              param.GetLowerEnergyLim(p)))
         , type_id(static_cast<InteractionType>(
                 crosssection::ParametrizationId<Param>::value))
     {
-        lower_energy_lim
-            = interpolant.GetDefinition().GetAxis().at(0)->GetLow();
+        lower_energy_lim = interpolant.GetLow();
     }
 
     double Calculate(double E) final;
@@ -15,7 +15,10 @@ namespace PROPOSAL {
                                             m(m),
                                             cut(cut),
                                             interpol(interpol),
-                                            param_name(_name::value){};
+                                            param_name(_name::value) {
+            for (auto const& c : m.GetComponents())
+                comp_hashes.push_back(c.GetHash());
+        };
         double CalculatedEdx(double energy) override {
             return param->CalculatedEdx(energy, p, m, cut); };
         double CalculatedE2dx(double energy) override {
@@ -37,6 +40,18 @@ namespace PROPOSAL {
         double CalculateStochasticLoss(size_t hash, double energy, double rate) override {
             return param->CalculateStochasticLoss(hash, energy, rate, p, m, cut);
         };
+        size_t GetNumComponents() const noexcept override {
+            return comp_hashes.size();
+        };
+        size_t GetComponentHash(size_t index) const override {
+            return comp_hashes.at(index);
+        };
+        double CalculatedNdx_ByIndex(double energy, size_t index) override {
+            return param->CalculatedNdx(energy, comp_hashes.at(index), p, m, cut);
+        };
+        double CalculateStochasticLoss_ByIndex(size_t index, double energy, double rate) override {
+            return param->CalculateStochasticLoss(comp_hashes.at(index), energy, rate, p, m, cut);
+        };
         double GetLowerEnergyLim() const override {
             return param->GetLowerEnergyLim(p, m, cut);
         };
@@ -61,6 +76,7 @@ namespace PROPOSAL {
         std::shared_ptr<const EnergyCutSettings> cut;
         bool interpol;
         std::string param_name;
+        std::vector<size_t> comp_hashes;
     };
 }
 
@@ -35,6 +35,22 @@ namespace PROPOSAL {
             return cross_->CalculateStochasticLoss(comp_hash, energy, rate/multiplier_);
         };
 
+        size_t GetNumComponents() const noexcept override {
+            return cross_->GetNumComponents();
+        }
+
+        size_t GetComponentHash(size_t index) const override {
+            return cross_->GetComponentHash(index);
+        }
+
+        double CalculatedNdx_ByIndex(double energy, size_t index) override {
+            return multiplier_ * cross_->CalculatedNdx_ByIndex(energy, index);
+        }
+
+        double CalculateStochasticLoss_ByIndex(size_t index, double energy, double rate) override {
+            return cross_->CalculateStochasticLoss_ByIndex(index, energy, rate/multiplier_);
+        }
+
         double GetLowerEnergyLim() const override {
             return cross_->GetLowerEnergyLim();
         }
@@ -24,6 +24,18 @@
 
 namespace PROPOSAL {
 
+using crosssection_builder_t = std::function<std::shared_ptr<CrossSectionBase>()>;
+
+// Builds the cross sections concurrently, each one builds its own tables.
+inline std::vector<std::shared_ptr<CrossSectionBase>> build_crosssections(
+    std::vector<crosssection_builder_t> const& builders)
+{
+    auto cross = std::vector<std::shared_ptr<CrossSectionBase>>(builders.size());
+    Helper::ParallelFor(
+        builders.size(), [&](size_t i) { cross[i] = builders[i](); });
+    return cross;
+}
+
 template<typename CrossVec>
 CrossVec append_cross(CrossVec& cross_vec) {
     return cross_vec;
@@ -32,11 +44,12 @@ CrossVec append_cross(CrossVec& cross_vec) {
 enum PARAMETRIZATION { PARAM, PARTICLE, MEDIUM, CUT, INTERPOLATE };
 template<typename CrossVec, typename P, typename... Args>
 void append_cross(CrossVec& cross_vec, P param, Args... args) {
-    cross_vec.push_back(make_crosssection(
+    cross_vec.push_back([param]() mutable {
+        return std::shared_ptr<CrossSectionBase>(make_crosssection(
                     std::get<PARAM>(param), std::get<PARTICLE>(param), std::get<MEDIUM>(param),
                     std::get<CUT>(param), std::get<INTERPOLATE>(param)
-        )
-    );
+        ));
+    });
     append_cross(cross_vec, args...);
 }
 
@@ -48,17 +61,17 @@ struct DefaultCrossSections{
     template <typename M, typename... Args>
     static auto Get(ParticleType const& particle, M const& medium, Args... args)
     {
-        auto cross = std::vector<std::shared_ptr<CrossSectionBase>>();
-        DefaultCrossSections<ParticleType>::Append(cross, particle, medium, args...);
-        return cross;
+        auto builders = std::vector<crosssection_builder_t>();
+        DefaultCrossSections<ParticleType>::Append(builders, particle, medium, args...);
+        return build_crosssections(builders);
     }
 
     template <typename M, typename... Args>
     static auto Get(ParticleDef const& particle, M const& medium, Args... args)
     {
-        auto cross = std::vector<std::shared_ptr<CrossSectionBase>>();
-        DefaultCrossSections<ParticleType>::Append(cross, particle, medium, args...);
-        return cross;
+        auto builders = std::vector<crosssection_builder_t>();
+        DefaultCrossSections<ParticleType>::Append(builders, particle, medium, args...);
+        return build_crosssections(builders);
     }
 };
 
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -59,7 +60,20 @@ public:
     // Public methods
     // --------------------------------------------------------------------- //
 
-    virtual std::vector<ParticleState> Decay(const ParticleDef&, const ParticleState&) = 0;
+    // ----------------------------------------------------------------------------
+    /// @brief Sample the decay products
+    ///
+    /// The random numbers are taken from the global RandomGenerator.
+    // ----------------------------------------------------------------------------
+    std::vector<ParticleState> Decay(const ParticleDef&, const ParticleState&);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Sample the decay products
+    ///
+    /// All random numbers are drawn from the given function, which has to
+    /// return uniformly distributed numbers in [0, 1).
+    // ----------------------------------------------------------------------------
+    virtual std::vector<ParticleState> Decay(const ParticleDef&, const ParticleState&, std::function<double()> rnd) = 0;
 
     // ----------------------------------------------------------------------------
     /// @brief Boost the particle along a direction
@@ -120,6 +134,7 @@ public:
     /// @return
     // ----------------------------------------------------------------------------
     static Cartesian3D GenerateRandomDirection();
+    static Cartesian3D GenerateRandomDirection(std::function<double()> rnd);
 
     // ----------------------------------------------------------------------------
     /// @brief Sets the uniform flag in the ManyBodyPhaseSpace channels
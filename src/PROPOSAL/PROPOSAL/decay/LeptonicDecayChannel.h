@@ -44,7 +44,8 @@ public:
     // No copy and assignemnt -> done by clone
     DecayChannel* clone() const { return new LeptonicDecayChannelApprox(*this); }
 
-    std::vector<ParticleState> Decay(const ParticleDef&, const ParticleState&);
+    using DecayChannel::Decay;
+    std::vector<ParticleState> Decay(const ParticleDef&, const ParticleState&, std::function<double()> rnd);
 
     const std::string& GetName() const { return name_; }
 
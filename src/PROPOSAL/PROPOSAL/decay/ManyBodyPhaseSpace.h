@@ -31,6 +31,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 
 #include "PROPOSAL/decay/DecayChannel.h"
 #include "PROPOSAL/particle/ParticleDef.h"
@@ -58,7 +59,7 @@ public:
 
     typedef std::unordered_map<ParticleDef, PhaseSpaceParameters> ParameterMap;
     typedef std::function<double(const ParticleState&, const std::vector<ParticleState>&)> MatrixElementFunction;
-    typedef std::function<void(PhaseSpaceParameters&, const ParticleDef&)> EstimateFunction;
+    typedef std::function<void(PhaseSpaceParameters&, const ParticleDef&, std::function<double()>)> EstimateFunction;
 
 public:
     ManyBodyPhaseSpace(std::vector<std::shared_ptr<const ParticleDef>> daughters, MatrixElementFunction ME = nullptr);
@@ -77,7 +78,8 @@ public:
     ///
     /// @return Vector of particles, the decay products
     // ----------------------------------------------------------------------------
-    std::vector<ParticleState> Decay(const ParticleDef& p_def, const ParticleState& p_condition);
+    using DecayChannel::Decay;
+    std::vector<ParticleState> Decay(const ParticleDef& p_def, const ParticleState& p_condition, std::function<double()> rnd);
 
     // ----------------------------------------------------------------------------
     /// @brief Evalutate the matrix element of this channel
@@ -124,7 +126,7 @@ private:
     ///
     /// @return Vector of particles, the decay products
     // ----------------------------------------------------------------------------
-    void GenerateEvent(std::vector<ParticleState>& products, const PhaseSpaceKinematics& kinematics);
+    void GenerateEvent(std::vector<ParticleState>& products, const PhaseSpaceKinematics& kinematics, std::function<double()> rnd);
 
     // ----------------------------------------------------------------------------
     /// @brief Calculate the normalization of the phase space density
@@ -146,7 +148,7 @@ private:
     ///
     /// @return maximum weight
     // ----------------------------------------------------------------------------
-    void EstimateMaxWeight(PhaseSpaceParameters&, const ParticleDef&);
+    void EstimateMaxWeight(PhaseSpaceParameters&, const ParticleDef&, std::function<double()>);
 
     // ----------------------------------------------------------------------------
     /// @brief Calculate the maximum weight for the phase space
@@ -159,7 +161,7 @@ private:
     ///
     /// @return maximum weight
     // ----------------------------------------------------------------------------
-    void SampleEstimateMaxWeight(PhaseSpaceParameters&, const ParticleDef&);
+    void SampleEstimateMaxWeight(PhaseSpaceParameters&, const ParticleDef&, std::function<double()>);
 
     // ----------------------------------------------------------------------------
     /// @brief Calculate the normalization and maximum weight
@@ -167,11 +169,12 @@ private:
     /// @param parent
     ///
     /// For every particle definition the normalization and maximum weight is unique.
-    /// Both values will be created and stored in an hash table.
+    /// Both values will be created and stored in an hash table, which is
+    /// guarded by a mutex so that decays can be sampled concurrently.
     ///
     /// @return struct containing the normalization and maximum weight
     // ----------------------------------------------------------------------------
-    PhaseSpaceParameters GetPhaseSpaceParams(const ParticleDef& parent_def);
+    PhaseSpaceParameters GetPhaseSpaceParams(const ParticleDef& parent_def, std::function<double()> rnd);
 
 
     // ----------------------------------------------------------------------------
@@ -183,7 +186,7 @@ private:
     /// @return struct containing the weight of the phase space point,
     ///         intermediate momenta and virtual masses for the algorithm.
     // ----------------------------------------------------------------------------
-    PhaseSpaceKinematics CalculateKinematics(double normalization, double parent_mass);
+    PhaseSpaceKinematics CalculateKinematics(double normalization, double parent_mass, std::function<double()> rnd);
 
     bool compare(const DecayChannel&) const;
     void print(std::ostream&) const;
@@ -203,6 +206,7 @@ private:
     static const std::string name_;
 
     ParameterMap parameter_map_;
+    std::mutex parameter_map_mutex_;
 };
 
 class ManyBodyPhaseSpace::Builder
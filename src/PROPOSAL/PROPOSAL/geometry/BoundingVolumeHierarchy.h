@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace PROPOSAL {
+class Geometry;
+class Vector3D;
+
+/*!
+ * Bounding volume hierarchy over the axis aligned bounding boxes of a list of
+ * geometries. It is built once and answers the two geometric queries of the
+ * propagation without testing every geometry: the geometry with the highest
+ * hierarchy containing a particle, and the distance to the closest border of
+ * all geometries with a higher hierarchy than the current one.
+ *
+ * Geometries are addressed by their index in the list passed on construction.
+ * The bounding boxes only preselect candidates, the final decision is always
+ * made by the geometries themselves, so the results are identical to a
+ * linear scan over the list. Geometries without a finite bounding box, see
+ * Geometry::GetBoundingBox(), are kept out of the tree and always tested.
+ */
+class BoundingVolumeHierarchy {
+public:
+    BoundingVolumeHierarchy() = default;
+    BoundingVolumeHierarchy(std::vector<std::shared_ptr<const Geometry>>);
+
+    /*!
+     * Index of the geometry with the highest hierarchy containing the given
+     * position. If several geometries with the same hierarchy contain the
+     * position, the one with the lowest index is returned.
+     * @return index of the geometry, or -1 if no geometry contains the
+     * position
+     */
+    int GetContainingGeometry(
+        const Vector3D& position, const Vector3D& direction) const;
+
+    /*!
+     * Smallest non-negative distance to the border of a geometry with a
+     * hierarchy higher than min_hierarchy along the given direction.
+     * @return distance to the border, or INF if no such border is crossed
+     */
+    double DistanceToBorder(const Vector3D& position,
+        const Vector3D& direction, unsigned int min_hierarchy) const;
+
+private:
+    struct AABB {
+        std::array<double, 3> lower;
+        std::array<double, 3> upper;
+    };
+
+    struct Node {
+        AABB box;
+        unsigned int max_hierarchy;
+        int left, right;      // child nodes, -1 for leaves
+        size_t first, count; // range of geometries in items_ for leaves
+    };
+
+    static constexpr size_t max_leaf_size = 4;
+
+    int Build(size_t first, size_t last);
+    static bool Contains(const AABB&, const std::array<double, 3>&);
+    static double Intersect(const AABB&, const std::array<double, 3>&,
+        const std::array<double, 3>&);
+
+    std::vector<std::shared_ptr<const Geometry>> geometries_;
+    std::vector<AABB> boxes_;
+    std::vector<size_t> items_;     // geometries in the tree
+    std::vector<size_t> unbounded_; // geometries tested on every query
+    std::vector<Node> nodes_;
+};
+} // namespace PROPOSAL
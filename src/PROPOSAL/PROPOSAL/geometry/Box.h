@@ -43,6 +43,7 @@ public:
 
     // Methods
     std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction) const override;
+    std::pair<Cartesian3D, Cartesian3D> GetBoundingBox() const override;
 
     // Getter & Setter
     double GetX() const { return x_; }
@@ -89,6 +89,13 @@ public:
      */
     double DistanceToClosestApproach(const Vector3D& position, const Vector3D& direction) const;
 
+    /*!
+     * Axis aligned box enclosing the geometry, given by its lower and upper
+     * corner. Used to build spatial indices over several geometries. By
+     * default, the box is unbounded, so the geometry is always tested.
+     */
+    virtual std::pair<Cartesian3D, Cartesian3D> GetBoundingBox() const;
+
     // void swap(Geometry &geometry);
 
     // ----------------------------------------------------------------- //
@@ -108,6 +108,14 @@ private:
      */
     double Interpolate(double x, int start);
 
+    /*!
+     * interpolates f(x) like Interpolate(x, start), but based on the values
+     * y[i]=f(iX[i]) and with the intermediate results c and d of the caller,
+     * so the members are only read if the precision is not tracked
+     */
+    double Interpolate(double x, int start, const std::vector<double>& y,
+        bool reverse, int starti, std::vector<double>& c, std::vector<double>& d);
+
     //----------------------------------------------------------------------------//
 
     /**
@@ -0,0 +1,104 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+namespace PROPOSAL {
+
+/*!
+ * Process-wide registry of the interpolants in use, identified by the name of
+ * their table, e.g. dndx_<hash>.dat. The hash in the name covers the
+ * parametrization, particle, medium, cuts and interpolation settings, so
+ * interpolants with the same name are identical. Cross sections and
+ * utilities of different sectors and propagators that need the same table
+ * share a single immutable interpolant instead of building or reading it
+ * again.
+ *
+ * The registry only keeps weak references, an interpolant is released as
+ * soon as the last object using it is destroyed.
+ */
+class InterpolantRegistry {
+public:
+    /*!
+     * Interpolant registered under name. If there is none, it is created by
+     * build() and registered. Concurrent requests for the same name wait
+     * until the first one has built the interpolant, requests for different
+     * names do not block each other.
+     */
+    template <typename T, typename Builder>
+    static std::shared_ptr<const T> Get(const std::string& name, Builder build)
+    {
+        auto slot = GetSlot(name);
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (auto stored = slot->interpolant.lock()) {
+            if (slot->type != std::type_index(typeid(T)))
+                throw std::logic_error("Interpolant " + name
+                    + " has been registered with a different type.");
+            return std::static_pointer_cast<const T>(stored);
+        }
+        auto interpolant = std::shared_ptr<const T>(build());
+        slot->interpolant = interpolant;
+        slot->type = std::type_index(typeid(T));
+        return interpolant;
+    }
+
+    /*!
+     * True if an interpolant is registered under name and still in use.
+     */
+    static bool Contains(const std::string& name);
+
+    /*!
+     * Number of registered interpolants which are still in use.
+     */
+    static size_t size();
+
+    /*!
+     * Forget all interpolants, following requests build new ones. Objects
+     * holding interpolants are not affected.
+     */
+    static void Clear();
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        std::weak_ptr<const void> interpolant;
+        std::type_index type = std::type_index(typeid(void));
+    };
+
+    struct State;
+
+    static State& GetState();
+    static std::shared_ptr<Slot> GetSlot(const std::string& name);
+};
+} // namespace PROPOSAL
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+#pragma once
+
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/math/SegmentedTable.h"
+
+#include "CubicInterpolation/BicubicSplines.h"
+#include "CubicInterpolation/CubicSplines.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace PROPOSAL {
+
+/*!
+ * Error controlled number of nodes of table segments.
+ *
+ * The nodes of the interpolants are equidistant in the transformed
+ * coordinates of their axes, so instead of placing single nodes, the number
+ * of nodes is chosen for every segment of a table, see EnergySegmentation.
+ * Starting from a coarse table, the number of intervals is doubled until the
+ * largest relative difference between table and function at the midpoints
+ * between the energy nodes is below InterpolationSettings::TABLE_TOLERANCE.
+ * Smooth segments therefore get fewer nodes than segments in which the
+ * function changes rapidly. The midpoints are the additional nodes of the
+ * next finer table, so every function value is only evaluated once if the
+ * function is wrapped by StoreValues.
+ */
+namespace NodeRefinement {
+    /*!
+     * Returns f, but stores its values, so that the values at the nodes are
+     * evaluated only once for all tables tried. Can be called concurrently.
+     */
+    std::function<double(double)> StoreValues(std::function<double(double)> f);
+    std::function<double(double, double)> StoreValues(
+        std::function<double(double, double)> f);
+
+    /*!
+     * Largest relative difference between the table of the definition and
+     * its function at the midpoints between the energy nodes, which are the
+     * nodes of the first axis. Differences at values below a thousandth of
+     * the largest value are taken relative to this thousandth.
+     */
+    double MidpointError(cubic_splines::CubicSplines<double>::Definition);
+    double MidpointError(cubic_splines::BicubicSplines<double>::Definition);
+
+    /*!
+     * Segments with the numbers of nodes tried for a segment, from coarse to
+     * fine. The number of nodes is part of their hash.
+     */
+    std::vector<EnergySegmentation::Segment> Candidates(
+        EnergySegmentation::Segment const&);
+
+    /*!
+     * True if the table is in use or stored in a table file or the archive.
+     */
+    bool IsStored(std::string const& name);
+
+    /*!
+     * Segment with the number of nodes required for its tolerance. Segments
+     * without tolerance are returned unchanged. If a table of the segment has
+     * been stored before, its number of nodes is used without refinement.
+     *
+     * @param create returns the definition of the table of a segment
+     * @param gen_name returns the name of the table with the given hash
+     */
+    template <typename Create>
+    EnergySegmentation::Segment Refine(EnergySegmentation::Segment const& segment,
+        Create create, std::function<std::string(size_t)> const& gen_name)
+    {
+        if (!(segment.tolerance > 0))
+            return segment;
+        auto candidates = Candidates(segment);
+        for (auto const& candidate : candidates)
+            if (IsStored(gen_name(candidate.hash)))
+                return candidate;
+        for (auto const& candidate : candidates)
+            if (MidpointError(create(candidate)) < segment.tolerance)
+                return candidate;
+        Logging::Get("TableCreation")->warn("Tolerance {} is not reached between {} and {} MeV "
+                                            "with {} nodes.", segment.tolerance, segment.low,
+                                            segment.up, candidates.back().nodes);
+        return candidates.back();
+    }
+} // namespace NodeRefinement
+} // namespace PROPOSAL
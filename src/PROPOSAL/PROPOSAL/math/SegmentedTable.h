@@ -0,0 +1,144 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PROPOSAL {
+
+/*!
+ * Energy range of an interpolation table, split into the segments the table
+ * is built in.
+ *
+ * By default, the range consists of a single segment. If
+ * InterpolationSettings::LAZY_TABLES or InterpolationSettings::TABLE_TOLERANCE
+ * is set, it is split at the multiples of
+ * InterpolationSettings::SEGMENT_DECADES decades. Every segment gets the
+ * share of the nodes corresponding to its logarithmic width or, with
+ * tolerance, the number of nodes required for it, see NodeRefinement.
+ */
+class EnergySegmentation {
+public:
+    struct Segment {
+        double low, up;
+        unsigned int nodes;
+        size_t hash; //!< hash of the table, combined with the segment
+                     //!< limits if the range is split
+        double tolerance; //!< relative tolerance or 0 for a fixed number
+                          //!< of nodes
+        unsigned int max_nodes; //!< nodes the tolerance may require at most
+    };
+
+    EnergySegmentation(double low, double up, unsigned int nodes, size_t hash);
+
+    /*!
+     * Index of the segment containing energy. Energies outside of the range
+     * are assigned to the first or the last segment.
+     */
+    size_t Find(double energy) const;
+
+    Segment const& GetSegment(size_t i) const { return segments_[i]; }
+    size_t size() const { return segments_.size(); }
+    double GetLow() const { return segments_.front().low; }
+    double GetUp() const { return segments_.back().up; }
+
+    /*!
+     * True if the segments are built on first use, i.e. if
+     * InterpolationSettings::LAZY_TABLES is set and
+     * InterpolationSettings::PRECOMPUTE_LAZY_TABLES is not. The latter
+     * keeps the segments, and thus the table names, of lazy tables.
+     */
+    bool IsLazy() const { return lazy_; }
+
+private:
+    std::vector<Segment> segments_;
+    bool lazy_;
+};
+
+/*!
+ * Interpolation table built segment-wise by the given builder. Without
+ * InterpolationSettings::LAZY_TABLES the table consists of a single segment,
+ * which is built on construction. Otherwise, a segment is built when a value
+ * in its energy range is requested for the first time, so only the energy
+ * range actually used by a simulation is tabulated. Segments can be
+ * requested concurrently.
+ */
+template <typename T> class SegmentedTable : public EnergySegmentation {
+public:
+    using builder_t = std::function<T(Segment const&)>;
+
+    SegmentedTable(double low, double up, unsigned int nodes, size_t hash,
+        builder_t build)
+        : EnergySegmentation(low, up, nodes, hash)
+        , build_(std::move(build))
+        , slots_(new Slot[size()])
+    {
+        if (!IsLazy())
+            BuildAll();
+    }
+
+    /*!
+     * Builds all segments which have not been built yet.
+     */
+    void BuildAll() const
+    {
+        for (size_t i = 0; i < size(); ++i)
+            Get(i);
+    }
+
+    /*!
+     * Table of segment i, which is built if necessary.
+     */
+    T const& Get(size_t i) const
+    {
+        auto& slot = slots_[i];
+        std::call_once(slot.built, [this, &slot, i]() {
+            slot.table = build_(GetSegment(i));
+        });
+        return slot.table;
+    }
+
+    /*!
+     * Table of the segment containing energy.
+     */
+    T const& At(double energy) const { return Get(Find(energy)); }
+
+private:
+    struct Slot {
+        std::once_flag built;
+        T table;
+    };
+
+    builder_t build_;
+    std::unique_ptr<Slot[]> slots_;
+};
+} // namespace PROPOSAL
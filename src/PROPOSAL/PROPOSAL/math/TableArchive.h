@@ -0,0 +1,243 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CubicInterpolation/BicubicSplines.h"
+#include "CubicInterpolation/CubicSplines.h"
+#include "PROPOSAL/math/TableLock.h"
+
+namespace PROPOSAL {
+
+/*!
+ * Read-only archive of the node values of all interpolation tables, stored
+ * in a single indexed binary file which is memory-mapped on opening.
+ *
+ * If InterpolationSettings::TABLES_ARCHIVE is set, the interpolants take the
+ * function values at their nodes from the archive instead of evaluating the
+ * integrals, and no per-table files are read or written. Tables that are not
+ * part of the archive yet are built and recorded, and are added to the
+ * archive by WritePending(), which is called by the Propagator after its
+ * tables have been built. Processes mapping the same archive share the same
+ * physical pages.
+ *
+ * Tables are identified by the file name the interpolant would use for its
+ * own table file, e.g. dndx_<hash>.dat. Together with the node values, the
+ * archive stores the limits of the axes and a checksum of every table, so
+ * tables that don't match their definition are created again. Tables whose
+ * values are reproduced within InterpolationSettings::ARCHIVE_FLOAT_PRECISION
+ * by single precision are stored as float, which halves their size.
+ */
+class TableArchive {
+public:
+    struct Table {
+        std::array<size_t, 2> nodes; //!< number of nodes per axis, the second
+                                     //!< one is 1 for one dimensional tables
+        std::array<std::array<double, 2>, 2> axes; //!< lower and upper limit
+                                                   //!< of the axes
+        bool single_precision;       //!< values are stored as float
+        const char* values;          //!< function values at the nodes
+        const char* derivatives;     //!< derivatives at the nodes or nullptr
+        size_t size;                 //!< bytes of values and derivatives
+        uint64_t checksum;           //!< of values and derivatives
+
+        double Value(size_t i) const;
+        double Derivative(size_t i) const;
+
+        /*!
+         * True if the stored data matches its checksum.
+         */
+        bool IsIntact() const;
+    };
+
+    /*!
+     * Node values of a table which is not part of a mapped archive.
+     */
+    struct TableData {
+        std::array<size_t, 2> nodes = { { 0, 1 } };
+        std::array<std::array<double, 2>, 2> axes = {};
+        std::vector<double> values;
+        std::vector<double> derivatives;
+    };
+
+    /*!
+     * Maps the archive file. Throws std::runtime_error if the file can not be
+     * opened or is not a valid archive.
+     */
+    explicit TableArchive(const std::string& file);
+    ~TableArchive();
+    TableArchive(const TableArchive&) = delete;
+    TableArchive& operator=(const TableArchive&) = delete;
+
+    /*!
+     * @return the table stored under name or nullptr if there is none
+     */
+    const Table* Find(const std::string& name) const;
+    std::vector<std::string> GetNames() const;
+    size_t size() const { return tables_.size(); }
+
+    /*!
+     * Writes an archive containing the given tables. The archive is written
+     * to a temporary file next to the target which is renamed afterwards, so
+     * processes that have the old archive mapped are not affected.
+     */
+    static void Write(
+        const std::string& file, const std::map<std::string, TableData>&);
+
+    /*!
+     * Archive configured by InterpolationSettings::TABLES_ARCHIVE, or nullptr
+     * if no archive is configured or the file does not exist yet.
+     */
+    static std::shared_ptr<const TableArchive> Get();
+
+    /*!
+     * True if InterpolationSettings::TABLES_ARCHIVE is set.
+     */
+    static bool IsEnabled();
+
+    /*!
+     * Directory that has to be passed to the interpolants for their own table
+     * files. Empty if the archive is enabled, which disables these files.
+     */
+    static std::string GetTablesPath();
+
+    /*!
+     * File name that has to be passed to the interpolants for their own table
+     * file. Empty if the archive is enabled.
+     */
+    static std::string GetTableFile(const std::string& name);
+
+    /*!
+     * Replace the function of a definition by the values stored under name
+     * in the archive. If the archive does not contain the table, the values
+     * the interpolant evaluates are recorded to be written by
+     * WritePending(). Without archive, the definition is returned unchanged.
+     */
+    static cubic_splines::CubicSplines<double>::Definition Use(
+        cubic_splines::CubicSplines<double>::Definition, const std::string& name);
+    static cubic_splines::BicubicSplines<double>::Definition Use(
+        cubic_splines::BicubicSplines<double>::Definition, const std::string& name);
+
+    /*!
+     * Creates the interpolant of the table stored under name. With archive,
+     * the node values are handled by Use(). Otherwise, the interpolant reads
+     * its table file or, if it does not exist yet, creates it. Processes
+     * sharing TABLES_PATH create a table file one at a time, see TableLock,
+     * and the others read it afterwards. The file is written under a
+     * temporary name and renamed when it is complete, so incomplete tables
+     * are never read.
+     */
+    template <typename T, typename Definition>
+    static std::shared_ptr<T> Create(Definition def, const std::string& name)
+    {
+        auto start = std::chrono::steady_clock::now();
+        def = Use(std::move(def), name);
+        auto path = GetTablesPath();
+        if (path.empty()) {
+            auto created = !IsArchived(name);
+            auto interpolant = std::make_shared<T>(std::move(def), "", "");
+            AddCreationTime(name, start, created);
+            return interpolant;
+        }
+
+        if (TableFileExists(path, name)) {
+            auto interpolant = std::make_shared<T>(std::move(def), path, name);
+            AddCreationTime(name, start, false);
+            return interpolant;
+        }
+
+        // the table may have been written while waiting for the lock, which
+        // GetWriteFile() checks again
+        TableLock lock(path + "/" + name);
+        auto file = GetWriteFile(path, name);
+        try {
+            auto interpolant = std::make_shared<T>(std::move(def), path, file);
+            MoveWrittenFile(path, file, name);
+            AddCreationTime(name, start, file != name);
+            return interpolant;
+        } catch (...) {
+            RemoveWrittenFile(path, file, name);
+            throw;
+        }
+    }
+
+    /*!
+     * Wall time spent in Create() for a table.
+     */
+    struct CreationTime {
+        std::string name;
+        double seconds;
+        bool created; //!< false if the table has been read
+    };
+
+    /*!
+     * Creation times of all tables passed through Create() since the last
+     * call, in the order they have been finished.
+     */
+    static std::vector<CreationTime> TakeCreationTimes();
+
+    /*!
+     * Adds all tables recorded since the last call to the configured archive.
+     * Does nothing if there are no recorded tables. Processes sharing the
+     * archive add their tables one at a time.
+     */
+    static void WritePending();
+
+private:
+    static bool TableFileExists(const std::string& path, const std::string& name);
+    // name of the file the interpolant has to use for the table name, which
+    // is a temporary file if the table file does not exist yet. Has to be
+    // called with the TableLock of the table held.
+    static std::string GetWriteFile(const std::string& path, const std::string& name);
+    static void MoveWrittenFile(const std::string& path, const std::string& file,
+        const std::string& name);
+    static void RemoveWrittenFile(const std::string& path, const std::string& file,
+        const std::string& name);
+    static bool IsArchived(const std::string& name);
+    static void AddCreationTime(const std::string& name,
+        std::chrono::steady_clock::time_point start, bool created);
+
+    void Map(const std::string& file);
+    void Unmap();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<char> buffer_; // used where memory mapping is not available
+    std::unordered_map<std::string, Table> tables_;
+};
+
+} // namespace PROPOSAL
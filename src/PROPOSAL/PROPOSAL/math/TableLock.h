@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+namespace PROPOSAL {
+
+/*!
+ * Exclusive lock shared by all processes using the same table file, e.g. all
+ * jobs of a cluster writing their tables to the same TABLES_PATH.
+ *
+ * The lock is an advisory record lock on the file <file>.lock, which is
+ * created if necessary and removed again when the lock is released. Locks of
+ * processes that terminate are released by the operating system, so no stale
+ * locks remain. If the lock is held by another process, the constructor
+ * blocks until it is released. Without support for record locks, the lock
+ * does nothing.
+ *
+ * The lock is not exclusive between threads of the same process.
+ */
+class TableLock {
+public:
+    explicit TableLock(const std::string& file);
+    ~TableLock();
+    TableLock(const TableLock&) = delete;
+    TableLock& operator=(const TableLock&) = delete;
+
+private:
+    std::string lock_file_;
+    int fd_ = -1;
+};
+
+} // namespace PROPOSAL
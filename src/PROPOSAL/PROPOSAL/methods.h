@@ -32,6 +32,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <sys/stat.h>
 // use unistd.h for access on POSIX os, use io.h for windows systems
@@ -92,6 +93,7 @@ struct LogTableCreation {
 
 private:
     static std::string warn_for_path;
+    static std::mutex mutex;
 };
 
 namespace Helper {
@@ -121,6 +123,20 @@ namespace Helper {
         return access( path_to_file.c_str(), 2 ) == 0;
     }
 
+    // ----------------------------------------------------------------------------
+    /// @brief Call f(i) for all i in [0, n) concurrently
+    ///
+    /// The calls are distributed over the calling thread and up to
+    /// InterpolationSettings::TABLE_BUILD_THREADS - 1 additional threads. The
+    /// additional threads are shared by all running and nested calls, if none
+    /// are left the calls are made by the calling thread only. The first
+    /// exception thrown by f is rethrown after all calls have finished.
+    ///
+    /// @param n: number of calls
+    /// @param f: function to be called with the index of the call
+    // ----------------------------------------------------------------------------
+    void ParallelFor(size_t n, std::function<void(size_t)> const& f);
+
 } // namespace Helper
 
 
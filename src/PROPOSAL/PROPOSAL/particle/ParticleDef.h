@@ -165,10 +165,12 @@ struct ParticleDef {
     friend std::ostream& operator<<(std::ostream&, ParticleDef const&);
 
     static ParticleDef GetParticleDefForType(int type);
+    static ParticleDef GetParticleDefForName(const std::string& name);
 
 private:
     static std::unique_ptr<std::unordered_map<int, ParticleDef>> Type_Particle_Map;
     static std::unordered_map<int, ParticleDef> create_particle_map();
+    static const std::unordered_map<int, ParticleDef>& GetTypeParticleMap();
     // ParticleDef& operator=(const ParticleDef&); // Undefined & not allowed
 
     /* std::unordered_map<size_t, std::vector<shared_ptr<CrossSection>>> */
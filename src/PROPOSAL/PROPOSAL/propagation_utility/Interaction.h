@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PROPOSAL/math/SegmentedTable.h"
+
 #include <memory>
 #include <vector>
 
@@ -21,6 +23,35 @@ protected:
     crosssection_list_t cross_list;
     size_t hash;
 
+    /*!
+     * Channel of a stochastic loss, i.e. a component of a crosssection. The
+     * channels are fixed by the crosssections, so they are set up once in the
+     * constructor.
+     */
+    struct Channel {
+        CrossSectionBase* crosssection;
+        size_t comp_index;
+    };
+    std::vector<Channel> channels;
+
+    /*!
+     * Cumulative rate fractions of the channels on a logarithmic energy grid,
+     * used if InterpolationSettings::NODES_CHANNEL_TABLE is positive. The
+     * channel of a loss is then chosen by interpolating the fractions
+     * linearly in log(E), so only the rate of the chosen channel has to be
+     * calculated. The grid is segmented like the other tables, so with
+     * InterpolationSettings::LAZY_TABLES a segment, and the dNdx tables it
+     * requires, is only built when a loss in its energy range is sampled.
+     */
+    struct ChannelTable {
+        double log_lower = 0;
+        double log_step = 0;
+        size_t nodes = 0;              // 0 if the segment has no table
+        std::vector<double> fractions; // channels of a node are contiguous
+        std::vector<bool> has_rate;    // no fractions if the total rate is 0
+    };
+    std::unique_ptr<SegmentedTable<ChannelTable>> channel_table;
+
     double calculate_total_rate(double energy) const;
 
 public:
@@ -33,21 +64,37 @@ public:
 
     struct Rate {
         cross_ptr crosssection;
-        size_t comp_hash;
+        size_t comp_index; //!< index of the component in the crosssection
         double rate;
     };
 
-    std::vector<Rate> Rates(double energy);
+    std::vector<Rate> Rates(double energy) const;
 
     struct Loss {
         InteractionType type;
         size_t comp_hash;
         double v_loss;
     };
-    Loss SampleLoss(double energy, std::vector<Rate> const& rates, double rnd);
+    Loss SampleLoss(
+        double energy, std::vector<Rate> const& rates, double rnd) const;
+
+    /*!
+     * Samples a stochastic loss like SampleLoss(energy, Rates(energy), rnd),
+     * but writes the rates into a thread_local scratch buffer, so the
+     * interaction can be shared between threads and no memory is allocated
+     * once the buffer has grown. If there is a channel table, the channel is
+     * chosen from it instead.
+     */
+    Loss SampleLoss(double energy, double rnd) const;
 
     virtual double MeanFreePath(double) = 0;
 
     auto GetHash() const noexcept { return hash; }
+
+private:
+    ChannelTable BuildChannelTable(EnergySegmentation::Segment const&) const;
+    bool SampleLossFromTable(double energy, double rnd, Loss& loss) const;
+    Loss LossNotSampled(double energy, double overall_rate,
+        double sampled_rate, double rnd) const;
 };
 } // namespace PROPOSAL
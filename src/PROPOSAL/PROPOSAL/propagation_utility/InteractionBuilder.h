@@ -1,5 +1,6 @@
 #pragma once
 #include "PROPOSAL/propagation_utility/Interaction.h"
+#include "PROPOSAL/math/SegmentedTable.h"
 #include "CubicInterpolation/CubicSplines.h"
 #include "CubicInterpolation/Interpolant.h"
 
@@ -16,11 +17,11 @@ class InteractionBuilder : public Interaction {
 
     using interpolant_t
         = cubic_splines::Interpolant<cubic_splines::CubicSplines<double>>;
-    using interpolant_ptr = std::shared_ptr<interpolant_t>;
-    interpolant_ptr rate_interpolant_;
+    using table_t = SegmentedTable<std::shared_ptr<const interpolant_t>>;
+    std::unique_ptr<table_t> rate_interpolant_;
     double rate_lower_energy_lim;
 
-    interpolant_ptr InitializeRateInterpolant();
+    std::unique_ptr<table_t> InitializeRateInterpolant();
 
 public:
     InteractionBuilder(std::shared_ptr<Displacement>,
@@ -66,13 +66,14 @@ public:
 
     PropagationUtility(Collection const& collection);
 
-    Interaction::Loss EnergyStochasticloss(double, double);
-    double EnergyDecay(double, std::function<double()>, double);
-    double EnergyInteraction(double, std::function<double()>);
-    double EnergyRandomize(double, double, std::function<double()>, double);
-    double EnergyDistance(double, double);
-    double LengthContinuous(double, double);
-    double TimeElapsed(double, double, double, double);
+    Interaction::Loss EnergyStochasticloss(double, double) const;
+    double EnergyDecay(double, std::function<double()>, double) const;
+    double EnergyInteraction(double, std::function<double()>) const;
+    double EnergyRandomize(
+        double, double, std::function<double()>, double) const;
+    double EnergyDistance(double, double) const;
+    double LengthContinuous(double, double) const;
+    double TimeElapsed(double, double, double, double) const;
 
     // TODO: return value doesn't tell what it include. Maybe it would be better
     // to give a tuple of two directions back. One is the mean over the
@@ -81,7 +82,7 @@ public:
     // in an enum.
 
     std::tuple<Cartesian3D, Cartesian3D> DirectionsScatter(
-        double, double, double, const Vector3D&, std::function<double()>);
+        double, double, double, const Vector3D&, std::function<double()>) const;
     Cartesian3D DirectionDeflect(InteractionType, double, double,
                                  const Vector3D&, std::function<double()>, 
                                  size_t) const;
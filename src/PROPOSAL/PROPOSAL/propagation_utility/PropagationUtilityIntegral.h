@@ -33,8 +33,6 @@
 
 namespace PROPOSAL {
 class UtilityIntegral {
-    Integral integral;
-
 protected:
     double lower_lim;
     std::function<double(double)> FunctionToIntegral;
@@ -30,6 +30,7 @@
 
 #include "CubicInterpolation/CubicSplines.h"
 #include "CubicInterpolation/Interpolant.h"
+#include "PROPOSAL/math/SegmentedTable.h"
 #include "PROPOSAL/propagation_utility/PropagationUtilityIntegral.h"
 
 #include <functional>
@@ -42,10 +43,23 @@ class Interpolant;
 class UtilityInterpolant : public UtilityIntegral {
     using interpolant_t
         = cubic_splines::Interpolant<cubic_splines::CubicSplines<double>>;
-    using interpolant_ptr = std::shared_ptr<interpolant_t>;
+
+    /*!
+     * Integral of a segment and, if InterpolationSettings::UTILITY_INVERSE_TABLES
+     * is set, its inverse. The inverse gives log(E) as a function of
+     * log1p(|integral - reference| / scale), where the reference is the
+     * integral at the lower edge and the scale the distance to it at the
+     * adjacent node, so the inverse is resolved on all scales of the integral.
+     */
+    struct Tables {
+        std::shared_ptr<const interpolant_t> integral;
+        std::shared_ptr<const interpolant_t> inverse;
+        double reference, scale, max_scaled;
+    };
+    using table_t = SegmentedTable<Tables>;
 
     double lower_lim;
-    interpolant_ptr interpolant_;
+    std::unique_ptr<table_t> interpolant_;
     bool reverse_;
 
     // maybe interpolate function to integral will give a performance boost.
@@ -53,8 +67,15 @@ class UtilityInterpolant : public UtilityIntegral {
     // Interpolant1DBuilder builder_diff;
     // std::unique_ptr<Interpolant> interpolant_diff_;
 
-    std::string gen_path() const;
-    std::string gen_name(std::string prefix) const;
+    std::string gen_name(std::string prefix, size_t hash) const;
+
+    // integral from energy_initial down to energy_final, which have to be
+    // in segment i of the table
+    double CalculateInSegment(size_t i, double energy_initial,
+                              double energy_final) const;
+    // energy in [low, up] at which the table of a segment takes value
+    double FindEnergy(interpolant_t const&, double value, double low,
+                      double up) const;
 
 public:
     UtilityInterpolant(std::function<double(double)>, double, size_t);
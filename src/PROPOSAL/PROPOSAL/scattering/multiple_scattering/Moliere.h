@@ -55,14 +55,21 @@ namespace multiple_scattering {
         int max_weight_index_; // index of the maximium of mass weights of
                                // different components
 
-        // scattering parameters
-        double chiCSq_; // characteristic angle² in rad²
-        std::vector<double> B_;
-
-        double f(double theta);
-        double F(double theta);
-        double GetRandom(double pre_factor, double rnd);
-        double GetPrefactor(double ei, double grammage);
+        // scattering parameters, depending on the energy and grammage of the
+        // current step. They are kept out of the class to allow concurrent
+        // sampling with the same parametrization, in a thread_local object
+        // which is reused for every step.
+        struct ScatteringParameters {
+            double chiCSq; // characteristic angle² in rad²
+            std::vector<double> B;
+        };
+
+        double f(double theta, const ScatteringParameters&);
+        double F(double theta, const ScatteringParameters&);
+        double GetRandom(
+            double pre_factor, double rnd, const ScatteringParameters&);
+        double GetPrefactor(
+            double ei, double grammage, ScatteringParameters&);
 
     protected:
         virtual double f1M(double x);
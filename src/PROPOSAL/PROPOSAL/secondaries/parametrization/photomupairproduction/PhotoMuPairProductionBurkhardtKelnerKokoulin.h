@@ -20,7 +20,7 @@ namespace secondaries {
                 using dndx_ptr = std::unique_ptr<CrossSectionDNDX>;
 
                 Medium medium;
-                std::unique_ptr<std::unordered_map<size_t, std::tuple<double, dndx_ptr>>> dndx;
+                std::unique_ptr<std::vector<std::tuple<double, dndx_ptr, size_t>>> dndx;
 
             public:
                 static constexpr int n_rnd = 2;
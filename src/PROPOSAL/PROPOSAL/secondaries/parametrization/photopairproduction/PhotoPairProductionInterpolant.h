@@ -21,7 +21,7 @@ namespace secondaries {
 
         Medium medium;
         std::unique_ptr<
-            std::unordered_map<size_t, std::tuple<double, dndx_ptr>>>
+            std::vector<std::tuple<double, dndx_ptr, size_t>>>
             dndx;
 
     public:
@@ -39,8 +39,8 @@ namespace secondaries {
             if (!dndx)
                 throw std::logic_error("dndx Interpolant for PhotoPairProduction not defined.");
             for (auto& it : *dndx) {
-                if (comp.GetHash() == it.first) {
-                    auto& calc = *std::get<1>(it.second);
+                if (comp.GetHash() == std::get<2>(it)) {
+                    auto& calc = *std::get<1>(it);
                     auto lim = calc.GetIntegrationLimits(energy);
                     auto rate = rnd * calc.Calculate(energy, lim.max);
                     auto rho = calc.GetUpperLimit(energy, rate);
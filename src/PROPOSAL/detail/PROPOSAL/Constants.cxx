@@ -25,6 +25,8 @@ const double PROPOSAL::IPREC2 = 1.e-6 * 10; // integration precision
 // interpolation parameters
 
 std::string InterpolationSettings::TABLES_PATH = "/tmp";
+std::string InterpolationSettings::TABLES_ARCHIVE = "";
+double InterpolationSettings::ARCHIVE_FLOAT_PRECISION = 0.;
 double InterpolationSettings::UPPER_ENERGY_LIM = 1.e14;
 unsigned int InterpolationSettings::NODES_DEDX = 500;
 unsigned int InterpolationSettings::NODES_DE2DX = 200;
@@ -32,6 +34,14 @@ unsigned int InterpolationSettings::NODES_DNDX_E = 100;
 unsigned int InterpolationSettings::NODES_DNDX_V = 100;
 unsigned int InterpolationSettings::NODES_UTILITY = 500;
 unsigned int InterpolationSettings::NODES_RATE_INTERPOLANT = 10000;
+unsigned int InterpolationSettings::TABLE_BUILD_THREADS = 0;
+bool InterpolationSettings::LAZY_TABLES = false;
+bool InterpolationSettings::PRECOMPUTE_LAZY_TABLES = false;
+double InterpolationSettings::SEGMENT_DECADES = 2.;
+double InterpolationSettings::TABLE_TOLERANCE = 0.;
+unsigned int InterpolationSettings::NODES_CHANNEL_TABLE = 0;
+bool InterpolationSettings::DNDX_INVERSE_TABLES = false;
+bool InterpolationSettings::UTILITY_INVERSE_TABLES = false;
 
 // propagation settings
 
@@ -9,3 +9,5 @@ std::shared_ptr<spdlog::sinks::sink> Logging::sink
     = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 
 spdlog::level::level_enum Logging::global_loglevel = spdlog::level::level_enum::warn;
+
+std::mutex Logging::mutex;
@@ -0,0 +1,92 @@
+#include "PROPOSAL/PropagationProfile.h"
+
+#include <iomanip>
+
+using namespace PROPOSAL;
+
+const char* PropagationProfile::GetPhaseName(size_t phase)
+{
+    static const std::array<const char*, NumberOfPhases> names = {
+        "EnergyInteraction",
+        "EnergyDecay",
+        "LengthContinuous",
+        "EnergyDistance",
+        "DensityCorrect",
+        "DirectionsScatter",
+        "DistanceToBorder",
+        "StochasticInteraction",
+        "EnergyRandomize",
+    };
+    return names.at(phase);
+}
+
+bool PropagationProfile::IsEnabled()
+{
+#ifdef PROPOSAL_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+PropagationProfile& PropagationProfile::ThisThread()
+{
+    thread_local PropagationProfile profile;
+    return profile;
+}
+
+PropagationProfile& PropagationProfile::operator+=(
+    const PropagationProfile& other)
+{
+    propagations += other.propagations;
+    total_seconds += other.total_seconds;
+    for (size_t i = 0; i < NumberOfPhases; ++i) {
+        calls[i] += other.calls[i];
+        seconds[i] += other.seconds[i];
+    }
+    return *this;
+}
+
+PropagationProfile& PropagationProfile::operator-=(
+    const PropagationProfile& other)
+{
+    propagations -= other.propagations;
+    total_seconds -= other.total_seconds;
+    for (size_t i = 0; i < NumberOfPhases; ++i) {
+        calls[i] -= other.calls[i];
+        seconds[i] -= other.seconds[i];
+    }
+    return *this;
+}
+
+namespace PROPOSAL {
+std::ostream& operator<<(std::ostream& os, const PropagationProfile& profile)
+{
+    if (!PropagationProfile::IsEnabled())
+        return os << "Profiling disabled, build PROPOSAL with "
+                     "-DPROPOSAL_PROFILING=ON.";
+
+    auto precision = os.precision();
+    os << "propagations: " << profile.propagations << ", total time: "
+       << profile.total_seconds << " s\n";
+    os << std::left << std::setw(24) << "phase" << std::right << std::setw(14)
+       << "calls" << std::setw(14) << "time [s]" << std::setw(12)
+       << "time [%]" << std::setw(14) << "per call [s]";
+    for (size_t i = 0; i < PropagationProfile::NumberOfPhases; ++i) {
+        auto fraction = profile.total_seconds > 0.
+            ? 100. * profile.seconds[i] / profile.total_seconds
+            : 0.;
+        auto per_call = profile.calls[i] > 0
+            ? profile.seconds[i] / profile.calls[i]
+            : 0.;
+        os << '\n'
+           << std::left << std::setw(24) << PropagationProfile::GetPhaseName(i)
+           << std::right << std::setw(14) << profile.calls[i]
+           << std::setw(14) << profile.seconds[i] << std::setw(12)
+           << std::setprecision(3) << fraction << std::setw(14)
+           << std::setprecision(6) << per_call;
+    }
+    os.precision(precision);
+    return os;
+}
+} // namespace PROPOSAL
@@ -0,0 +1,50 @@
+#include "PROPOSAL/PropagationStatistics.h"
+
+#include <algorithm>
+
+using namespace PROPOSAL;
+
+PropagationStatistics& PropagationStatistics::operator+=(
+    const PropagationStatistics& other)
+{
+    propagations += other.propagations;
+    advance_particle_calls += other.advance_particle_calls;
+    advance_particle_iterations += other.advance_particle_iterations;
+    advance_particle_max_iterations = std::max(
+        advance_particle_max_iterations, other.advance_particle_max_iterations);
+    invalid_steps += other.invalid_steps;
+    backscatter_resamples += other.backscatter_resamples;
+    unreachable_step_resamples += other.unreachable_step_resamples;
+    max_steps_reached += other.max_steps_reached;
+    density_exception_fallbacks += other.density_exception_fallbacks;
+    utility_bisection_fallbacks += other.utility_bisection_fallbacks;
+    dndx_bisection_fallbacks += other.dndx_bisection_fallbacks;
+    return *this;
+}
+
+namespace PROPOSAL {
+std::ostream& operator<<(std::ostream& os, const PropagationStatistics& s)
+{
+    os << "propagations: " << s.propagations << '\n';
+    os << "advance particle calls: " << s.advance_particle_calls << '\n';
+    os << "advance particle iterations: " << s.advance_particle_iterations
+       << " (max " << s.advance_particle_max_iterations << " per call)\n";
+    os << "invalid steps: " << s.invalid_steps << '\n';
+    os << "backscatter resamples: " << s.backscatter_resamples << '\n';
+    os << "unreachable step resamples: " << s.unreachable_step_resamples
+       << '\n';
+    os << "max steps reached: " << s.max_steps_reached << '\n';
+    os << "density exception fallbacks: " << s.density_exception_fallbacks
+       << '\n';
+    os << "utility bisection fallbacks: " << s.utility_bisection_fallbacks
+       << '\n';
+    os << "dndx bisection fallbacks: " << s.dndx_bisection_fallbacks;
+    return os;
+}
+} // namespace PROPOSAL
+
+InterpolantFallbacks& InterpolantFallbacks::ThisThread()
+{
+    thread_local InterpolantFallbacks fallbacks;
+    return fallbacks;
+}
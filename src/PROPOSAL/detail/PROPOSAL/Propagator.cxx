@@ -18,6 +18,7 @@
 #include "PROPOSAL/density_distr/density_distr.h"
 #include "PROPOSAL/geometry/GeometryFactory.h"
 #include "PROPOSAL/math/RandomGenerator.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/medium/MediumFactory.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 #include "PROPOSAL/propagation_utility/ContRandBuilder.h"
@@ -25,7 +26,11 @@
 #include "PROPOSAL/propagation_utility/InteractionBuilder.h"
 #include "PROPOSAL/propagation_utility/TimeBuilder.h"
 #include "PROPOSAL/scattering/ScatteringFactory.h"
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 #include <iomanip>
 
@@ -33,54 +38,254 @@ using namespace PROPOSAL;
 using std::get;
 using std::string;
 
+namespace {
+// Stores the reported steps of a propagation in a Secondaries object. In the
+// reduced recording modes, the latest continuous state is held back and only
+// stored if it is needed, e.g. as the state before a stochastic loss or as
+// the final state in Finish().
+class TrackRecorder : public PropagationSink {
+    Secondaries& track;
+    TrackRecording mode;
+    ParticleState last_state;
+    bool is_initial = true;
+    bool has_last_state = false;
+
+public:
+    TrackRecorder(Secondaries& track, TrackRecording mode)
+        : track(track)
+        , mode(mode)
+    {
+    }
+
+    void OnContinuousStep(const ParticleState& state) override
+    {
+        if (mode == TrackRecording::Full || is_initial) {
+            track.push_back(state, InteractionType::ContinuousEnergyLoss);
+            is_initial = false;
+            return;
+        }
+        last_state = state;
+        has_last_state = true;
+    }
+
+    void OnStochasticLoss(const ParticleState& state, InteractionType type,
+        double, size_t target_hash) override
+    {
+        switch (mode) {
+        case TrackRecording::Full:
+            track.push_back(state, type, target_hash);
+            break;
+        case TrackRecording::StochasticLosses:
+            if (has_last_state)
+                track.push_back(
+                    last_state, InteractionType::ContinuousEnergyLoss);
+            track.push_back(state, type, target_hash);
+            has_last_state = false;
+            break;
+        case TrackRecording::Endpoints:
+            // without the state before it, the final state can not be
+            // stored as a loss, see Finish()
+            last_state = state;
+            has_last_state = true;
+            break;
+        }
+    }
+
+    void OnDecay(const ParticleState& state) override
+    {
+        has_last_state = false;
+        track.push_back(state, InteractionType::Decay);
+    }
+
+    void Finish()
+    {
+        if (has_last_state)
+            // stored as continuous loss, since the energy difference to the
+            // previous state is not a single stochastic loss in the reduced
+            // recording modes
+            track.push_back(last_state, InteractionType::ContinuousEnergyLoss);
+        has_last_state = false;
+    }
+};
+} // namespace
+
 Propagator::Propagator(const ParticleDef& p_def, std::vector<Sector> sectors)
-    : p_def(p_def)
-    , sector_list(sectors)
+    : p_def(std::make_shared<ParticleDef>(p_def))
+    , sector_list(std::make_shared<const SectorList>(std::move(sectors)))
 {
+    // the tables of the sectors are built by now
+    TableArchive::WritePending();
 }
 
 Propagator::Propagator(const ParticleDef& p_def, const nlohmann::json& config)
-    : p_def(p_def)
+    : p_def(std::make_shared<ParticleDef>(p_def))
 {
     GlobalSettings global;
     if (config.contains("global"))
         global = GlobalSettings(config["global"]);
+    std::vector<Sector> sectors;
     if (config.contains("sectors")) {
         assert(config["sectors"].is_array());
         for (const auto& json_sector : config.at("sectors")) {
-            InitializeSectorFromJSON(p_def, json_sector, global);
+            InitializeSectorFromJSON(p_def, json_sector, global, sectors);
         }
     } else {
         throw std::invalid_argument("No sector array found in json object");
     }
+    sector_list = std::make_shared<const SectorList>(std::move(sectors));
+    TableArchive::WritePending();
 }
 
 Secondaries Propagator::Propagate(const ParticleState& initial_particle,
     double max_distance, double min_energy, unsigned int hierarchy_condition)
 {
-    Secondaries track(std::make_shared<ParticleDef>(p_def), sector_list);
+    Secondaries track(p_def, sector_list);
+    Propagate(initial_particle, track, max_distance, min_energy,
+        hierarchy_condition);
+    return track;
+}
 
-    track.push_back(initial_particle, InteractionType::ContinuousEnergyLoss);
-    auto state = ParticleState(initial_particle);
+Secondaries Propagator::Propagate(const ParticleState& initial_particle,
+    std::mt19937& rng, double max_distance, double min_energy,
+    unsigned int hierarchy_condition)
+{
+    Secondaries track(p_def, sector_list);
+    Propagate(initial_particle, track, rng, max_distance, min_energy,
+        hierarchy_condition);
+    return track;
+}
 
-    auto current_sector = GetCurrentSector(state.position, state.direction);
+void Propagator::Propagate(const ParticleState& initial_particle,
+    Secondaries& out, double max_distance, double min_energy,
+    unsigned int hierarchy_condition)
+{
+    out.reset(p_def, sector_list);
+    TrackRecorder recorder(out, track_recording);
+    Propagate(initial_particle, recorder, max_distance, min_energy,
+        hierarchy_condition);
+    recorder.Finish();
+}
+
+void Propagator::Propagate(const ParticleState& initial_particle,
+    Secondaries& out, std::mt19937& rng, double max_distance,
+    double min_energy, unsigned int hierarchy_condition)
+{
+    out.reset(p_def, sector_list);
+    TrackRecorder recorder(out, track_recording);
+    Propagate(initial_particle, recorder, rng, max_distance, min_energy,
+        hierarchy_condition);
+    recorder.Finish();
+}
+
+void Propagator::Propagate(const ParticleState& initial_particle,
+    PropagationSink& sink, double max_distance, double min_energy,
+    unsigned int hierarchy_condition)
+{
     auto rnd
         = std::bind(&RandomGenerator::RandomDouble, &RandomGenerator::Get());
+    DoPropagation(initial_particle, sink, rnd, max_distance, min_energy,
+        hierarchy_condition);
+}
+
+void Propagator::Propagate(const ParticleState& initial_particle,
+    PropagationSink& sink, std::mt19937& rng, double max_distance,
+    double min_energy, unsigned int hierarchy_condition)
+{
+    auto uniform = std::uniform_real_distribution<double>(0., 1.);
+    auto rnd = [&rng, uniform]() mutable { return uniform(rng); };
+    DoPropagation(initial_particle, sink, rnd, max_distance, min_energy,
+        hierarchy_condition);
+}
+
+std::vector<Secondaries> Propagator::PropagateBatch(
+    const std::vector<ParticleState>& initial_particles, unsigned int seed,
+    unsigned int n_threads, double max_distance, double min_energy,
+    unsigned int hierarchy_condition)
+{
+    auto n_events = initial_particles.size();
+    if (n_threads == 0)
+        n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    n_threads = std::min<size_t>(n_threads, std::max<size_t>(n_events, 1));
+
+    // Secondaries are not default constructible, so the workers fill slots
+    // addressed by the event index which are moved to the output afterwards.
+    auto tracks = std::vector<std::unique_ptr<Secondaries>>(n_events);
+    std::atomic<size_t> next_event { 0 };
+    std::exception_ptr error = nullptr;
+    std::mutex error_mutex;
+
+    auto worker = [&]() {
+        for (auto i = next_event++; i < n_events; i = next_event++) {
+            try {
+                auto index = static_cast<uint64_t>(i);
+                std::seed_seq seq { seed, static_cast<unsigned int>(index),
+                    static_cast<unsigned int>(index >> 32) };
+                auto rng = std::mt19937(seq);
+                tracks[i] = std::make_unique<Secondaries>(
+                    Propagate(initial_particles[i], rng, max_distance,
+                        min_energy, hierarchy_condition));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next_event = n_events; // stop all workers
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < n_threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    std::vector<Secondaries> output;
+    output.reserve(n_events);
+    for (auto& track : tracks)
+        output.emplace_back(std::move(*track));
+    return output;
+}
+
+void Propagator::DoPropagation(const ParticleState& initial_particle,
+    PropagationSink& sink, std::function<double()> rnd, double max_distance,
+    double min_energy, unsigned int hierarchy_condition)
+{
+    sink.OnContinuousStep(initial_particle);
+    auto state = ParticleState(initial_particle);
+
+    auto stats = PropagationStatistics();
+    auto fallbacks_before = InterpolantFallbacks::ThisThread();
+#ifdef PROPOSAL_PROFILING
+    auto profile_before = PropagationProfile::ThisThread();
+    auto start_time = std::chrono::steady_clock::now();
+#endif
+
+    auto current_sector = &GetCurrentSector(state.position, state.direction);
 
     int advancement_type;
     auto continue_propagation = true;
 
     std::array<double, 3> InteractionEnergy;
     while (continue_propagation) {
-        auto& utility = get<UTILITY>(current_sector);
-        auto& density = get<DENSITY_DISTR>(current_sector);
+        auto& utility = get<UTILITY>(*current_sector);
+        auto& density = get<DENSITY_DISTR>(*current_sector);
 
         InteractionEnergy[MinimalE] = std::max(
                 min_energy, utility.collection.displacement_calc->GetLowerLim());
-        InteractionEnergy[Decay] = utility.EnergyDecay(
-            state.energy, rnd, density->Evaluate(state.position));
-        InteractionEnergy[Stochastic]
-            = utility.EnergyInteraction(state.energy, rnd);
+        {
+            PROPOSAL_PROFILE_PHASE(EnergyDecay);
+            InteractionEnergy[Decay] = utility.EnergyDecay(
+                state.energy, rnd, density->Evaluate(state.position));
+        }
+        {
+            PROPOSAL_PROFILE_PHASE(EnergyInteraction);
+            InteractionEnergy[Stochastic]
+                = utility.EnergyInteraction(state.energy, rnd);
+        }
 
         auto next_interaction_type = maximize(InteractionEnergy);
         auto energy_at_next_interaction
@@ -89,29 +294,30 @@ Secondaries Propagator::Propagate(const ParticleState& initial_particle,
         advancement_type = AdvanceParticle(
                 state, energy_at_next_interaction, max_distance, rnd,
                 current_sector, next_interaction_type == MinimalE,
-                InteractionEnergy[MinimalE]);
+                InteractionEnergy[MinimalE], stats);
 
         // If the particle is on the sector border before the continuous step is
         // performed in 'AdvanceParticle', we might enter a different sector due
-        // to multiple scattering. Therefore, we have to update current_sector.
-        utility = get<UTILITY>(current_sector);
-        density = get<DENSITY_DISTR>(current_sector);
-
-        track.push_back(state, InteractionType::ContinuousEnergyLoss);
+        // to multiple scattering. In this case, 'AdvanceParticle' has updated
+        // current_sector and the utility has to be taken from there.
+        sink.OnContinuousStep(state);
 
         switch (advancement_type) {
         case ReachedInteraction:
             switch (next_interaction_type) {
             case Stochastic: {
-                auto loss = DoStochasticInteraction(state, utility, rnd);
+                auto energy_before_loss = state.energy;
+                auto loss = DoStochasticInteraction(
+                    state, get<UTILITY>(*current_sector), rnd);
                 if (loss.type != InteractionType::Undefined)
-                    track.push_back(state, loss.type, loss.comp_hash);
+                    sink.OnStochasticLoss(state, loss.type,
+                        energy_before_loss - state.energy, loss.comp_hash);
                 if (state.energy <= InteractionEnergy[MinimalE])
                     continue_propagation = false;
                 break;
             }
             case Decay: {
-                track.push_back(state, InteractionType::Decay);
+                sink.OnDecay(state);
                 continue_propagation = false;
                 break;
             }
@@ -122,9 +328,13 @@ Secondaries Propagator::Propagate(const ParticleState& initial_particle,
             }
             break;
         case ReachedBorder: {
-            auto hierarchy_i = get<GEOMETRY>(current_sector)->GetHierarchy();
-            current_sector = GetCurrentSector(state.position, state.direction);
-            auto hierarchy_f = get<GEOMETRY>(current_sector)->GetHierarchy();
+            auto& geometry_i = *get<GEOMETRY>(*current_sector);
+            current_sector = &GetCurrentSector(state.position, state.direction);
+            auto& geometry_f = *get<GEOMETRY>(*current_sector);
+            if (&geometry_i != &geometry_f)
+                sink.OnBorderCrossing(state, geometry_i, geometry_f);
+            auto hierarchy_i = geometry_i.GetHierarchy();
+            auto hierarchy_f = geometry_f.GetHierarchy();
             if (hierarchy_i > hierarchy_condition
                 && hierarchy_f < hierarchy_condition)
                 continue_propagation = false;
@@ -135,12 +345,31 @@ Secondaries Propagator::Propagate(const ParticleState& initial_particle,
             break;
         }
     }
-    return track;
+
+    if (collect_statistics) {
+        auto& fallbacks = InterpolantFallbacks::ThisThread();
+        stats.propagations = 1;
+        stats.utility_bisection_fallbacks
+            = fallbacks.utility_bisection - fallbacks_before.utility_bisection;
+        stats.dndx_bisection_fallbacks
+            = fallbacks.dndx_bisection - fallbacks_before.dndx_bisection;
+        statistics.Add(stats);
+    }
+
+#ifdef PROPOSAL_PROFILING
+    auto profile = PropagationProfile::ThisThread();
+    profile -= profile_before;
+    profile.propagations = 1;
+    profile.total_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time).count();
+    this->profile.Add(profile);
+#endif
 }
 
 Interaction::Loss Propagator::DoStochasticInteraction(ParticleState& p_cond,
-    PropagationUtility& utility, std::function<double()> rnd)
+    const PropagationUtility& utility, std::function<double()> rnd)
 {
+    PROPOSAL_PROFILE_PHASE(StochasticInteraction);
     auto loss = utility.EnergyStochasticloss(p_cond.energy, rnd());
 
     p_cond.direction = utility.DirectionDeflect(loss.type, p_cond.energy,
@@ -152,12 +381,13 @@ Interaction::Loss Propagator::DoStochasticInteraction(ParticleState& p_cond,
 
 int Propagator::AdvanceParticle(ParticleState &state,
     const double energy_next_interaction, const double final_distance,
-    std::function<double()> rnd_generator, Sector& current_sector,
-    bool min_energy_step, const double min_energy) {
+    std::function<double()> rnd_generator, const Sector*& current_sector,
+    bool min_energy_step, const double min_energy,
+    PropagationStatistics& stats) {
 
-    auto& utility = get<UTILITY>(current_sector);
-    auto& density = get<DENSITY_DISTR>(current_sector);
-    auto& geometry = get<GEOMETRY>(current_sector);
+    auto utility = &get<UTILITY>(*current_sector);
+    auto density = get<DENSITY_DISTR>(*current_sector).get();
+    auto geometry = get<GEOMETRY>(*current_sector).get();
 
     double energy = energy_next_interaction; // final energy of proposed step
     double grammage = -1; // grammage of proposed step
@@ -167,8 +397,12 @@ int Propagator::AdvanceParticle(ParticleState &state,
     const double max_distance = final_distance - state.propagated_distance;
 
     // Calculate grammage until next stochastic interaction
-    double grammage_next_interaction = utility.LengthContinuous(
-            state.energy, energy_next_interaction);
+    double grammage_next_interaction;
+    {
+        PROPOSAL_PROFILE_PHASE(LengthContinuous);
+        grammage_next_interaction = utility->LengthContinuous(
+                state.energy, energy_next_interaction);
+    }
 
     int advancement_type;
     Cartesian3D mean_direction, new_direction; // proposed scattering
@@ -192,10 +426,15 @@ int Propagator::AdvanceParticle(ParticleState &state,
         // Calculate grammage, energy and distance for step
         if (energy != -1 && distance == -1) {
             // Calculate grammage and distance from given energy
-            grammage = utility.LengthContinuous(state.energy, energy);
+            {
+                PROPOSAL_PROFILE_PHASE(LengthContinuous);
+                grammage = utility->LengthContinuous(state.energy, energy);
+            }
             try {
+                PROPOSAL_PROFILE_PHASE(DensityCorrect);
                 distance = density->Correct(state.position, state.direction, grammage, max_distance);
             } catch (const DensityException&) {
+                stats.density_exception_fallbacks++;
                 distance = INF;
             }
         } else if (energy == -1 && distance != -1) {
@@ -203,21 +442,25 @@ int Propagator::AdvanceParticle(ParticleState &state,
             auto grammage_step = density->Calculate(state.position, state.direction, distance);
             if (grammage_step < grammage_next_interaction) {
                 grammage = grammage_step;
-                energy = utility.EnergyDistance(state.energy, grammage);
+                PROPOSAL_PROFILE_PHASE(EnergyDistance);
+                energy = utility->EnergyDistance(state.energy, grammage);
             } else {
                 // we are unable to reach `distance` before we reach the next interaction
                 // this means we are stuck in a loop, and need to discard the current set of random numbers
                 for (auto& r: random_numbers) {
                     r = rnd_generator();
                 }
+                stats.unreachable_step_resamples++;
                 Logging::Get("proposal.propagator")->debug("Unable to find a valid combination of propagation step "
                                                            "length and multiple scattering angle for this set of "
                                                            "random numbers. Resample set of random numbers.");
                 grammage = grammage_next_interaction;
                 energy = energy_next_interaction;
                 try {
+                    PROPOSAL_PROFILE_PHASE(DensityCorrect);
                     distance = density->Correct(state.position, state.direction, grammage, max_distance);
                 } catch (const DensityException&) {
+                    stats.density_exception_fallbacks++;
                     distance = INF;
                 }
             }
@@ -228,8 +471,11 @@ int Propagator::AdvanceParticle(ParticleState &state,
         }
 
         // Calculate scattering proposal
-        std::tie(mean_direction, new_direction) = utility.DirectionsScatter(
-                grammage, state.energy, energy, state.direction, rnd);
+        {
+            PROPOSAL_PROFILE_PHASE(DirectionsScatter);
+            std::tie(mean_direction, new_direction) = utility->DirectionsScatter(
+                    grammage, state.energy, energy, state.direction, rnd);
+        }
 
         // Check step
         double distance_to_border = CalculateDistanceToBorder(state.position, mean_direction, *geometry);
@@ -237,6 +483,7 @@ int Propagator::AdvanceParticle(ParticleState &state,
 
         if (num_steps > PropagationSettings::ADVANCE_PARTICLE_MAX_STEPS) {
             // too many iteration steps!
+            stats.max_steps_reached++;
             Logging::Get("proposal.propagator")->warn("Maximal number of iteration step exceeded ({}). "
                                                       "Proposed propagation step is {} cm, while distance to border is "
                                                       "{} cm (difference of {} cm). Initial energy particle {} MeV, "
@@ -247,17 +494,23 @@ int Propagator::AdvanceParticle(ParticleState &state,
                                                       state.energy, energy);
             distance = distance_to_border;
             grammage = density->Calculate(state.position, state.direction, distance);
-            energy = utility.EnergyDistance(state.energy, grammage);
+            {
+                PROPOSAL_PROFILE_PHASE(EnergyDistance);
+                energy = utility->EnergyDistance(state.energy, grammage);
+            }
             advancement_type = ReachedBorder;
         } else if (!is_inside) {
             // Special case: We are on the sector border, but scattering back outside the current sector!
             // Update sector and recalculate values
             advancement_type = InvalidStep;
-            auto new_sector = GetCurrentSector(state.position, mean_direction);
-            utility = get<UTILITY>(new_sector);
-            density = get<DENSITY_DISTR>(new_sector);
-            geometry = get<GEOMETRY>(new_sector);
-            grammage_next_interaction = utility.LengthContinuous(state.energy, energy_next_interaction);
+            current_sector = &GetCurrentSector(state.position, mean_direction);
+            utility = &get<UTILITY>(*current_sector);
+            density = get<DENSITY_DISTR>(*current_sector).get();
+            geometry = get<GEOMETRY>(*current_sector).get();
+            {
+                PROPOSAL_PROFILE_PHASE(LengthContinuous);
+                grammage_next_interaction = utility->LengthContinuous(state.energy, energy_next_interaction);
+            }
             energy = energy_next_interaction;
             distance = -1;
             grammage = -1;
@@ -269,6 +522,7 @@ int Propagator::AdvanceParticle(ParticleState &state,
                 for (auto& r: random_numbers) {
                     r = rnd_generator();
                 }
+                stats.backscatter_resamples++;
             }
             backscatter = true;
         } else if (distance <= distance_to_border && distance <= max_distance && energy == energy_next_interaction) {
@@ -288,16 +542,25 @@ int Propagator::AdvanceParticle(ParticleState &state,
             energy = -1;
             grammage = -1;
         }
+        if (advancement_type == InvalidStep)
+            stats.invalid_steps++;
     } while (advancement_type == InvalidStep);
 
-    state.time = state.time + utility.TimeElapsed(state.energy, energy, grammage, density->Evaluate(state.position)); // TODO: should the energy passed here be the randomized energy or not?
+    stats.advance_particle_calls++;
+    stats.advance_particle_iterations += num_steps;
+    stats.advance_particle_max_iterations = std::max(
+        stats.advance_particle_max_iterations, static_cast<size_t>(num_steps));
+
+    state.time = state.time + utility->TimeElapsed(state.energy, energy, grammage, density->Evaluate(state.position)); // TODO: should the energy passed here be the randomized energy or not?
     state.position = state.position + distance * mean_direction;
     state.direction = new_direction;
     state.propagated_distance = state.propagated_distance + distance;
-    if (min_energy_step && advancement_type == ReachedInteraction)
+    if (min_energy_step && advancement_type == ReachedInteraction) {
         state.energy = energy; // we reached a specific energy, no randomization
-    else
-        state.energy = utility.EnergyRandomize(state.energy, energy, rnd, min_energy);
+    } else {
+        PROPOSAL_PROFILE_PHASE(EnergyRandomize);
+        state.energy = utility->EnergyRandomize(state.energy, energy, rnd, min_energy);
+    }
 
     return advancement_type;
 }
@@ -305,19 +568,8 @@ int Propagator::AdvanceParticle(ParticleState &state,
 double Propagator::CalculateDistanceToBorder(const Vector3D& position,
     const Vector3D& direction, const Geometry& current_geometry)
 {
-    auto distance_border
-        = current_geometry.DistanceToBorder(position, direction).first;
-    double tmp_distance;
-    for (auto& sector : sector_list) {
-        auto& geometry = get<GEOMETRY>(sector);
-        if (geometry->GetHierarchy() > current_geometry.GetHierarchy()) {
-            tmp_distance
-                = geometry->DistanceToBorder(position, direction).first;
-            if (tmp_distance >= 0)
-                distance_border = std::min(distance_border, tmp_distance);
-        }
-    }
-    return distance_border;
+    PROPOSAL_PROFILE_PHASE(DistanceToBorder);
+    return sector_list->DistanceToBorder(position, direction, current_geometry);
 }
 
 int Propagator::maximize(const std::array<double, 3>& InteractionEnergies)
@@ -334,29 +586,10 @@ int Propagator::minimize(const std::array<double, 3>& AdvanceDistances)
     return std::distance(AdvanceDistances.begin(), min_element_ref);
 }
 
-Sector Propagator::GetCurrentSector(
+const Sector& Propagator::GetCurrentSector(
     const Vector3D& position, const Vector3D& direction)
 {
-    auto potential_sec = std::vector<Sector*> {};
-    for (auto& sector : sector_list) {
-        if (get<GEOMETRY>(sector)->IsInside(position, direction))
-            potential_sec.push_back(&sector);
-    }
-
-    if (potential_sec.empty()) {
-        auto spherical_position = Cartesian3D(position);
-        Logging::Get("proposal.propagator")->critical("No sector defined at particle position {}, {}, {}.",
-                                                      spherical_position.GetX(),
-                                                      spherical_position.GetY(),
-                                                      spherical_position.GetZ());
-    }
-    auto highest_sector_iter = std::max_element(
-        potential_sec.begin(), potential_sec.end(), [](Sector* a, Sector* b) {
-            return get<GEOMETRY>(*a)->GetHierarchy()
-                < get<GEOMETRY>(*b)->GetHierarchy();
-        });
-
-    return **highest_sector_iter;
+    return sector_list->GetCurrentSector(position, direction);
 }
 
 // Init methods
@@ -387,7 +620,8 @@ nlohmann::json Propagator::ParseConfig(const string& config_file)
 }
 
 void Propagator::InitializeSectorFromJSON(const ParticleDef& p_def,
-    const nlohmann::json& json_sector, GlobalSettings global)
+    const nlohmann::json& json_sector, GlobalSettings global,
+    std::vector<Sector>& sectors)
 {
     bool do_interpolation
         = json_sector.value("do_interpolation", global.do_interpolation);
@@ -436,7 +670,7 @@ void Propagator::InitializeSectorFromJSON(const ParticleDef& p_def,
         for (const auto& json_geometry : json_sector.at("geometries")) {
             auto geometry = CreateGeometry(json_geometry);
             auto density = CreateDensityDistribution(density_distr);
-            sector_list.emplace_back(
+            sectors.emplace_back(
                 std::make_tuple(geometry, utility, density));
         }
     } else {
@@ -451,21 +685,40 @@ PropagationUtility::Collection Propagator::CreateUtility(
     bool do_exact_time, nlohmann::json scatter)
 {
     PropagationUtility::Collection def;
-    def.displacement_calc = make_displacement(crosss, do_interpol);
-    def.interaction_calc
-        = make_interaction(def.displacement_calc, crosss, do_interpol, false);
+    auto builders = std::vector<std::function<void()>>();
+    builders.emplace_back([&]() {
+        def.displacement_calc = make_displacement(crosss, do_interpol);
+        def.interaction_calc = make_interaction(
+            def.displacement_calc, crosss, do_interpol, false);
+    });
     if (!scatter.empty())
-        def.scattering
-            = make_scattering(scatter, p_def, *medium, crosss, do_interpol);
-    if (std::isfinite(p_def.lifetime))
-        def.decay_calc = make_decay(crosss, p_def, do_interpol);
+        builders.emplace_back([&]() {
+            def.scattering = make_scattering(
+                scatter, *p_def, *medium, crosss, do_interpol);
+        });
+    if (std::isfinite(p_def->lifetime))
+        builders.emplace_back([&]() {
+            def.decay_calc = make_decay(crosss, *p_def, do_interpol);
+        });
     if (do_cont_rand)
-        def.cont_rand = make_contrand(crosss, do_interpol);
+        builders.emplace_back(
+            [&]() { def.cont_rand = make_contrand(crosss, do_interpol); });
     if (do_exact_time) {
-        def.time_calc = make_time(crosss, p_def, do_interpol);
+        builders.emplace_back(
+            [&]() { def.time_calc = make_time(crosss, *p_def, do_interpol); });
     } else {
         def.time_calc = std::make_shared<ApproximateTimeBuilder>();
     }
+
+    // The utilities only evaluate the cross sections, which is thread safe
+    // for interpolated ones, so their tables are built concurrently. Cross
+    // sections evaluated by integration are built sequentially.
+    if (do_interpol) {
+        Helper::ParallelFor(builders.size(), [&](size_t i) { builders[i](); });
+    } else {
+        for (auto& build : builders)
+            build();
+    }
     return def;
 }
 
@@ -474,52 +727,76 @@ Propagator::CreateCrossSectionList(const ParticleDef& p_def,
     const Medium& medium, std::shared_ptr<const EnergyCutSettings> cuts,
     bool interpolate, double density_correction, const nlohmann::json& config)
 {
-    std::vector<std::shared_ptr<CrossSectionBase>> cross;
+    // the cross sections are independent of each other and build their
+    // tables concurrently
+    std::vector<crosssection_builder_t> cross;
 
     if (config.contains("annihilation"))
-        cross.emplace_back(make_annihilation(
-            p_def, medium, interpolate, config["annihilation"]));
+        cross.emplace_back([&]() {
+            return make_annihilation(
+                p_def, medium, interpolate, config["annihilation"]);
+        });
     if (config.contains("brems"))
-        cross.emplace_back(make_bremsstrahlung(p_def, medium, cuts, interpolate,
-            config["brems"], density_correction));
+        cross.emplace_back([&]() {
+            return make_bremsstrahlung(p_def, medium, cuts, interpolate,
+                config["brems"], density_correction);
+        });
     if (config.contains("compton"))
-        cross.emplace_back(
-            make_compton(p_def, medium, cuts, interpolate, config["compton"]));
+        cross.emplace_back([&]() {
+            return make_compton(
+                p_def, medium, cuts, interpolate, config["compton"]);
+        });
     if (config.contains("epair"))
-        cross.emplace_back(make_epairproduction(p_def, medium, cuts,
-            interpolate, config["epair"], density_correction));
+        cross.emplace_back([&]() {
+            return make_epairproduction(p_def, medium, cuts, interpolate,
+                config["epair"], density_correction);
+        });
     if (config.contains("ioniz"))
-        cross.emplace_back(
-            make_ionization(p_def, medium, cuts, interpolate, config["ioniz"]));
+        cross.emplace_back([&]() {
+            return make_ionization(
+                p_def, medium, cuts, interpolate, config["ioniz"]);
+        });
     if (config.contains("mupair"))
-        cross.emplace_back(make_mupairproduction(
-            p_def, medium, cuts, interpolate, config["mupair"]));
+        cross.emplace_back([&]() {
+            return make_mupairproduction(
+                p_def, medium, cuts, interpolate, config["mupair"]);
+        });
     if (config.contains("photo")) {
-        try {
-            cross.emplace_back(make_photonuclearreal(
-                p_def, medium, cuts, interpolate, config["photo"]));
-        } catch (std::invalid_argument& e) {
-            cross.emplace_back(make_photonuclearQ2(
-                p_def, medium, cuts, interpolate, config["photo"]));
-        }
+        cross.emplace_back([&]() {
+            try {
+                return make_photonuclearreal(
+                    p_def, medium, cuts, interpolate, config["photo"]);
+            } catch (std::invalid_argument& e) {
+                return make_photonuclearQ2(
+                    p_def, medium, cuts, interpolate, config["photo"]);
+            }
+        });
     }
     if (config.contains("photoeffect"))
-        cross.emplace_back(make_photoeffect(
-            p_def, medium, config["photoeffect"]));
+        cross.emplace_back([&]() {
+            return make_photoeffect(p_def, medium, config["photoeffect"]);
+        });
     if (config.contains("photomupair"))
-        cross.emplace_back(make_photomupairproduction(
-            p_def, medium, interpolate, config["photomupair"]));
+        cross.emplace_back([&]() {
+            return make_photomupairproduction(
+                p_def, medium, interpolate, config["photomupair"]);
+        });
     if (config.contains("photoproduction"))
-        cross.emplace_back(make_photoproduction(
-            p_def, medium, config["photoproduction"]));
+        cross.emplace_back([&]() {
+            return make_photoproduction(
+                p_def, medium, config["photoproduction"]);
+        });
     if (config.contains("photopair"))
-        cross.emplace_back(make_photopairproduction(
-                p_def, medium, interpolate, config["photopair"],
-                density_correction));
+        cross.emplace_back([&]() {
+            return make_photopairproduction(p_def, medium, interpolate,
+                config["photopair"], density_correction);
+        });
     if (config.contains("weak"))
-        cross.emplace_back(
-            make_weakinteraction(p_def, medium, interpolate, config["weak"]));
-    return cross;
+        cross.emplace_back([&]() {
+            return make_weakinteraction(
+                p_def, medium, interpolate, config["weak"]);
+        });
+    return build_crosssections(cross);
 }
 
 Propagator::GlobalSettings::GlobalSettings(const nlohmann::json& config_global)
@@ -16,24 +16,72 @@ using std::get;
 using namespace PROPOSAL;
 
 Secondaries::Secondaries(std::shared_ptr<ParticleDef> p_def,
-                         std::vector<Sector> sectors)
+                         std::shared_ptr<const SectorList> sectors)
     : primary_def_(p_def)
     , sectors_(sectors)
 {
 }
 
+Secondaries::Secondaries(std::shared_ptr<ParticleDef> p_def,
+                         std::vector<Sector> sectors)
+    : Secondaries(p_def, std::make_shared<const SectorList>(std::move(sectors)))
+{
+}
+
 
 void Secondaries::reserve(size_t number_secondaries)
 {
-    track_.reserve(number_secondaries);
+    energy_.reserve(number_secondaries);
+    time_.reserve(number_secondaries);
+    distance_.reserve(number_secondaries);
+    x_.reserve(number_secondaries);
+    y_.reserve(number_secondaries);
+    z_.reserve(number_secondaries);
+    dx_.reserve(number_secondaries);
+    dy_.reserve(number_secondaries);
+    dz_.reserve(number_secondaries);
+    particle_types_.reserve(number_secondaries);
     types_.reserve(number_secondaries);
     target_hashes_.reserve(number_secondaries);
 }
 
+void Secondaries::clear()
+{
+    energy_.clear();
+    time_.clear();
+    distance_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    dx_.clear();
+    dy_.clear();
+    dz_.clear();
+    particle_types_.clear();
+    types_.clear();
+    target_hashes_.clear();
+}
+
+void Secondaries::reset(std::shared_ptr<ParticleDef> p_def,
+                        std::shared_ptr<const SectorList> sectors)
+{
+    clear();
+    primary_def_ = std::move(p_def);
+    sectors_ = std::move(sectors);
+}
+
 void Secondaries::push_back(const ParticleState& point,
                             const InteractionType& type, const size_t& target_hash)
 {
-    track_.push_back(point);
+    energy_.push_back(point.energy);
+    time_.push_back(point.time);
+    distance_.push_back(point.propagated_distance);
+    x_.push_back(point.position.GetX());
+    y_.push_back(point.position.GetY());
+    z_.push_back(point.position.GetZ());
+    dx_.push_back(point.direction.GetX());
+    dy_.push_back(point.direction.GetY());
+    dz_.push_back(point.direction.GetZ());
+    particle_types_.push_back(point.type);
     types_.push_back(type);
     target_hashes_.push_back(target_hash);
 }
@@ -43,25 +91,57 @@ void Secondaries::emplace_back(const ParticleType& particle_type, const Vector3D
     const double& distance, const InteractionType& interaction_type,
     const size_t& target_hash)
 {
-    track_.emplace_back(particle_type, position, direction, energy, time,
-                        distance);
-    types_.emplace_back(interaction_type);
-    target_hashes_.push_back(target_hash);
+    push_back(ParticleState(particle_type, position, direction, energy, time,
+                  distance),
+        interaction_type, target_hash);
+}
+
+ParticleState Secondaries::GetState(size_t idx) const
+{
+    auto state = ParticleState(GetPosition(idx), GetDirection(idx),
+        energy_[idx], time_[idx], distance_[idx]);
+    state.type = particle_types_[idx];
+    return state;
+}
+
+Cartesian3D Secondaries::GetPosition(size_t idx) const
+{
+    return Cartesian3D(x_[idx], y_[idx], z_[idx]);
+}
+
+Cartesian3D Secondaries::GetDirection(size_t idx) const
+{
+    return Cartesian3D(dx_[idx], dy_[idx], dz_[idx]);
+}
+
+bool Secondaries::IsStochasticLoss(size_t idx) const
+{
+    return types_[idx] != InteractionType::ContinuousEnergyLoss
+        && types_[idx] != InteractionType::Decay;
 }
 
 std::vector<ParticleState> Secondaries::GetDecayProducts() const
 {
-    assert(track_.size() == types_.size());
+    return DoDecay(std::bind(&RandomGenerator::RandomDouble, &RandomGenerator::Get()));
+}
+
+std::vector<ParticleState> Secondaries::GetDecayProducts(std::mt19937& rng) const
+{
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    return DoDecay([&rng, uniform]() mutable { return uniform(rng); });
+}
 
+std::vector<ParticleState> Secondaries::DoDecay(std::function<double()> rnd) const
+{
     //TODO: Is this necessary, or do we assume that there is only one decay at the end of the vector?
     std::vector<ParticleState> decay_products;
-    for (unsigned int i=0; i<track_.size(); i++) {
+    for (unsigned int i=0; i<size(); i++) {
         if (types_[i] == InteractionType::Decay) {
-            ParticleState decaying_particle = track_[i];
-            double random_ch = RandomGenerator::Get().RandomDouble();
+            ParticleState decaying_particle = GetState(i);
+            double random_ch = rnd();
             auto products
                 = primary_def_->decay_table.SelectChannel(random_ch).Decay(
-                    *primary_def_, decaying_particle);
+                    *primary_def_, decaying_particle, rnd);
             for (auto p : products) {
                 decay_products.emplace_back(p);
             }
@@ -70,12 +150,21 @@ std::vector<ParticleState> Secondaries::GetDecayProducts() const
     return decay_products;
 }
 
+std::vector<ParticleState> Secondaries::GetTrack() const
+{
+    std::vector<ParticleState> vec;
+    vec.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+        vec.push_back(GetState(i));
+    return vec;
+}
+
 std::vector<ParticleState> Secondaries::GetTrack(const Geometry& geometry) const
 {
     std::vector<ParticleState> vec;
-    for (auto i : track_) {
-        if (geometry.IsInside(i.position, i.direction))
-            vec.push_back(i);
+    for (size_t i = 0; i < size(); ++i) {
+        if (geometry.IsInside(GetPosition(i), GetDirection(i)))
+            vec.push_back(GetState(i));
     }
     return vec;
 }
@@ -83,82 +172,75 @@ std::vector<ParticleState> Secondaries::GetTrack(const Geometry& geometry) const
 
 ParticleState Secondaries::GetStateForEnergy(double energy) const
 {
-    if (energy >= track_.front().energy)
-        return track_.front();
+    if (energy >= energy_.front())
+        return GetState(0);
 
-    for (unsigned int i=1; i<track_.size(); i++) {
-        if (track_[i].energy < energy) {
+    for (unsigned int i=1; i<size(); i++) {
+        if (energy_[i] < energy) {
             if (types_[i] == InteractionType::ContinuousEnergyLoss) {
-                auto displacement = track_[i].position - track_[i-1].position;
+                auto displacement = GetPosition(i) - GetPosition(i-1);
                 displacement.normalize();
                 return RePropagateEnergy(
-                        track_[i-1], displacement, track_[i-1].energy - energy,
-                        track_[i-1].propagated_distance - track_[i].propagated_distance);
+                        GetState(i-1), displacement, energy_[i-1] - energy,
+                        distance_[i-1] - distance_[i]);
             } else {
-                return track_[i-1];
+                return GetState(i-1);
             }
         }
     }
 
-    return track_.back();
+    return back();
 }
 
 ParticleState Secondaries::GetStateForDistance(double propagated_distance) const
 {
-    if (track_.front().propagated_distance >= propagated_distance)
-        return track_.front();
+    if (distance_.front() >= propagated_distance)
+        return GetState(0);
 
-    for (unsigned int i=1; i<track_.size(); i++) {
-        if (track_[i].propagated_distance > propagated_distance) {
-            auto displacement = track_[i].position - track_[i-1].position;
+    for (unsigned int i=1; i<size(); i++) {
+        if (distance_[i] > propagated_distance) {
+            auto displacement = GetPosition(i) - GetPosition(i-1);
             displacement.normalize();
             return RePropagateDistance(
-                    track_[i-1], displacement,
-                    propagated_distance - track_[i-1].propagated_distance);
+                    GetState(i-1), displacement,
+                    propagated_distance - distance_[i-1]);
         }
     }
 
-    return track_.back();
+    return back();
 }
 
 std::vector<Cartesian3D> Secondaries::GetTrackPositions() const
 {
     std::vector<Cartesian3D> vec;
-    for (auto i : track_)
-        vec.emplace_back(i.position);
+    vec.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+        vec.emplace_back(GetPosition(i));
     return vec;
 }
 
 std::vector<Cartesian3D> Secondaries::GetTrackDirections() const
 {
     std::vector<Cartesian3D> vec;
-    for (auto i : track_)
-        vec.emplace_back(i.direction);
+    vec.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+        vec.emplace_back(GetDirection(i));
     return vec;
 }
 
 std::vector<double> Secondaries::GetTrackEnergies() const
 {
-    std::vector<double> vec;
-    for (auto i : track_)
-        vec.emplace_back(i.energy);
-    return vec;
+    return energy_;
 }
 
 std::vector<double> Secondaries::GetTrackTimes() const
 {
-    std::vector<double> vec;
-    for (auto i : track_)
-        vec.emplace_back(i.time);
-    return vec;
+    return time_;
 }
 
 std::vector<double> Secondaries::GetTrackPropagatedDistances() const
 {
-    std::vector<double> vec;
-    for (auto i : track_)
-        vec.emplace_back(i.propagated_distance);
-    return vec;
+    return distance_;
 }
 
 double Secondaries::GetELost(const Geometry& geometry) const
@@ -171,17 +253,17 @@ double Secondaries::GetELost(const Geometry& geometry) const
 std::shared_ptr<ParticleState> Secondaries::GetEntryPoint(
         const Geometry& geometry) const
 {
-    auto pos_0 = track_.front().position;
-    auto dir_0 = track_.front().direction;
+    auto pos_0 = GetPosition(0);
+    auto dir_0 = GetDirection(0);
     if (geometry.IsEntering(pos_0, dir_0))
-        return std::make_unique<ParticleState>(track_.front());
+        return std::make_unique<ParticleState>(GetState(0));
     if (geometry.IsInside(pos_0, dir_0))
         return nullptr; // track starts in geometry
 
-    for (unsigned int i = 0; i < track_.size() - 1; i++) {
-        auto pos_i = track_[i].position;
-        auto pos_f = track_[i+1].position;
-        auto dir_i = track_[i].direction;
+    for (unsigned int i = 0; i < size() - 1; i++) {
+        auto pos_i = GetPosition(i);
+        auto pos_f = GetPosition(i+1);
+        auto dir_i = GetDirection(i);
 
         auto displacement = pos_f - pos_i;
         auto dist_i_f = displacement.magnitude();
@@ -190,8 +272,8 @@ std::shared_ptr<ParticleState> Secondaries::GetEntryPoint(
         auto distance = geometry.DistanceToBorder(pos_i, displacement).first;
         if (distance <= dist_i_f && distance >= 0) {
             if (std::abs(dist_i_f - distance) < PARTICLE_POSITION_RESOLUTION)
-                return std::make_unique<ParticleState>(track_[i+1]);
-            auto entry_point = RePropagateDistance(track_[i], displacement,
+                return std::make_unique<ParticleState>(GetState(i+1));
+            auto entry_point = RePropagateDistance(GetState(i), displacement,
                                                    distance);
             return std::make_unique<ParticleState>(entry_point);
         }
@@ -202,17 +284,17 @@ std::shared_ptr<ParticleState> Secondaries::GetEntryPoint(
 std::shared_ptr<ParticleState> Secondaries::GetExitPoint(
         const Geometry &geometry) const
 {
-    auto pos_end = track_.back().position;
-    auto dir_end = track_.back().direction;
+    auto pos_end = GetPosition(size() - 1);
+    auto dir_end = GetDirection(size() - 1);
     if (geometry.IsLeaving(pos_end, dir_end))
-        return std::make_unique<ParticleState>(track_.back());
+        return std::make_unique<ParticleState>(back());
     if (geometry.IsInside(pos_end, dir_end))
         return nullptr; // track ends inside geometry
 
-    for (auto i = track_.size() - 1; i > 0; i--) {
-        auto pos_i = track_[i-1].position;
-        auto pos_f = track_[i].position;
-        auto dir_i = track_[i-1].direction;
+    for (auto i = size() - 1; i > 0; i--) {
+        auto pos_i = GetPosition(i-1);
+        auto pos_f = GetPosition(i);
+        auto dir_i = GetDirection(i-1);
 
         auto displacement = pos_f - pos_i;
         auto dist_i_f = displacement.magnitude();
@@ -221,17 +303,17 @@ std::shared_ptr<ParticleState> Secondaries::GetExitPoint(
         auto distance = geometry.DistanceToBorder(pos_f, -displacement).first;
         if (distance <= dist_i_f && distance >= 0) {
             if (std::abs(dist_i_f - distance) < PARTICLE_POSITION_RESOLUTION)
-                return std::make_unique<ParticleState>(track_[i-1]);
+                return std::make_unique<ParticleState>(GetState(i-1));
             auto exit_point = RePropagateDistance(
-                    track_[i-1], displacement, dist_i_f - distance);
+                    GetState(i-1), displacement, dist_i_f - distance);
             return std::make_unique<ParticleState>(exit_point);
         }
     }
 
-    auto pos_0 = track_.front().position;
-    auto dir_0 = track_.front().direction;
+    auto pos_0 = GetPosition(0);
+    auto dir_0 = GetDirection(0);
     if (geometry.IsLeaving(pos_0, dir_0))
-        return std::make_unique<ParticleState>(track_.front());
+        return std::make_unique<ParticleState>(GetState(0));
 
     return nullptr; // No exit point found
 }
@@ -239,12 +321,12 @@ std::shared_ptr<ParticleState> Secondaries::GetExitPoint(
 std::shared_ptr<ParticleState> Secondaries::GetClosestApproachPoint(
         const Geometry& geometry) const
 {
-   if (track_.size() == 1)
-       return std::make_unique<ParticleState>(track_.front());
+   if (size() == 1)
+       return std::make_unique<ParticleState>(GetState(0));
 
-    for (unsigned int i = 0; i < track_.size() - 1; i++) {
-        auto pos_i = track_[i].position;
-        auto pos_f = track_[i+1].position;
+    for (unsigned int i = 0; i < size() - 1; i++) {
+        auto pos_i = GetPosition(i);
+        auto pos_f = GetPosition(i+1);
 
         auto displacement = pos_f - pos_i;
         auto dist_i_f = displacement.magnitude();
@@ -253,23 +335,23 @@ std::shared_ptr<ParticleState> Secondaries::GetClosestApproachPoint(
         auto distance_to_closest_approach
             = geometry.DistanceToClosestApproach(pos_i, displacement);
         if (std::abs(distance_to_closest_approach - dist_i_f) <= PARTICLE_POSITION_RESOLUTION) {
-            return std::make_unique<ParticleState>(track_[i+1]);
+            return std::make_unique<ParticleState>(GetState(i+1));
         } else if (distance_to_closest_approach < dist_i_f) {
             if (distance_to_closest_approach < PARTICLE_POSITION_RESOLUTION)
-                return std::make_unique<ParticleState>(track_[i]);
+                return std::make_unique<ParticleState>(GetState(i));
 
             auto closest_approach = RePropagateDistance(
-                    track_[i], displacement, distance_to_closest_approach);
+                    GetState(i), displacement, distance_to_closest_approach);
             return std::make_unique<ParticleState>(closest_approach);
         }
     }
-    return std::make_unique<ParticleState>(track_.back());
+    return std::make_unique<ParticleState>(back());
 }
 
 bool Secondaries::HitGeometry(const Geometry& geometry) const {
-    for (unsigned int i = 0; i < track_.size() - 1; i++) {
-        auto pos_a = track_[i].position;
-        auto pos_b = track_[i+1].position;
+    for (unsigned int i = 0; i < size() - 1; i++) {
+        auto pos_a = GetPosition(i);
+        auto pos_b = GetPosition(i+1);
         auto disp = (pos_b - pos_a);
         disp.normalize();
 
@@ -283,7 +365,7 @@ bool Secondaries::HitGeometry(const Geometry& geometry) const {
     }
 
     // check if last track point is in geometry
-    if (geometry.IsInside(track_.back().position, track_.back().direction))
+    if (geometry.IsInside(GetPosition(size() - 1), GetDirection(size() - 1)))
         return true;
 
     return false;
@@ -294,7 +376,7 @@ ParticleState Secondaries::RePropagateEnergy(const ParticleState& init,
                                              double energy_lost,
                                              double max_distance) const
 {
-    auto current_sector = GetCurrentSector(init.position, direction);
+    auto& current_sector = GetCurrentSector(init.position, direction);
     auto& utility = get<Propagator::UTILITY>(current_sector);
     auto& density = get<Propagator::DENSITY_DISTR>(current_sector);
 
@@ -322,7 +404,7 @@ ParticleState Secondaries::RePropagateDistance(const ParticleState& init,
                                                const Cartesian3D& direction,
                                                double displacement) const
 {
-    auto current_sector = GetCurrentSector(init.position, direction);
+    auto& current_sector = GetCurrentSector(init.position, direction);
     auto& utility = get<Propagator::UTILITY>(current_sector);
     auto& density = get<Propagator::DENSITY_DISTR>(current_sector);
 
@@ -342,43 +424,22 @@ ParticleState Secondaries::RePropagateDistance(const ParticleState& init,
                          direction, E_f, new_time, new_propagated_distance);
 }
 
-Sector Secondaries::GetCurrentSector(const Vector3D& position,
-                                     const Vector3D& direction) const
+const Sector& Secondaries::GetCurrentSector(const Vector3D& position,
+                                            const Vector3D& direction) const
 {
-    //TODO: this is essentially a duplicate of Propagator::GetCurrentSector
-    auto potential_sec = std::vector<Sector const*>{};
-    for (auto& sector : sectors_) {
-        if (get<Propagator::GEOMETRY>(sector)->IsInside(position, direction))
-            potential_sec.push_back(&sector);
-    }
-
-    if (potential_sec.empty())
-        throw std::logic_error(
-                "Propagator: No sector defined at current particle position.");
-
-    auto highest_sector_iter = std::max_element(
-            potential_sec.begin(), potential_sec.end(), [](Sector const* a, Sector const* b) {
-                return get<Propagator::GEOMETRY>(*a)->GetHierarchy()
-                       < get<Propagator::GEOMETRY>(*b)->GetHierarchy();
-            });
-
-    return **highest_sector_iter;
+    return sectors_->GetCurrentSector(position, direction);
 }
 
 std::vector<StochasticLoss> Secondaries::GetStochasticLosses() const
 {
-    assert(track_.size() == types_.size());
-
     std::vector<StochasticLoss> losses;
-    for (unsigned int i=1; i<track_.size(); i++) {
-        auto interaction_type = types_[i];
-        if (interaction_type != InteractionType::ContinuousEnergyLoss &&
-                interaction_type != InteractionType::Decay) {
-            losses.emplace_back(static_cast<int>(interaction_type),
-                                track_[i-1].energy - track_[i].energy,
-                                track_[i].position, track_[i].direction,
-                                track_[i].time, track_[i].propagated_distance,
-                                track_[i-1].energy, target_hashes_[i]);
+    for (unsigned int i=1; i<size(); i++) {
+        if (IsStochasticLoss(i)) {
+            losses.emplace_back(static_cast<int>(types_[i]),
+                                energy_[i-1] - energy_[i],
+                                GetPosition(i), GetDirection(i),
+                                time_[i], distance_[i],
+                                energy_[i-1], target_hashes_[i]);
         }
     }
     return losses;
@@ -386,19 +447,15 @@ std::vector<StochasticLoss> Secondaries::GetStochasticLosses() const
 
 std::vector<StochasticLoss> Secondaries::GetStochasticLosses(const Geometry& geometry) const
 {
-    assert(track_.size() == types_.size());
-
     std::vector<StochasticLoss> losses;
-    for (unsigned int i=1; i<track_.size(); i++) {
-        if (geometry.IsInside(track_[i].position, track_[i].direction)) {
-            auto interaction_type = types_[i];
-            if (interaction_type != InteractionType::ContinuousEnergyLoss &&
-               interaction_type != InteractionType::Decay) {
-                losses.emplace_back(static_cast<int>(interaction_type),
-                                    track_[i-1].energy - track_[i].energy,
-                                    track_[i].position, track_[i].direction,
-                                    track_[i].time, track_[i].propagated_distance,
-                                    track_[i-1].energy, target_hashes_[i]);
+    for (unsigned int i=1; i<size(); i++) {
+        if (geometry.IsInside(GetPosition(i), GetDirection(i))) {
+            if (IsStochasticLoss(i)) {
+                losses.emplace_back(static_cast<int>(types_[i]),
+                                    energy_[i-1] - energy_[i],
+                                    GetPosition(i), GetDirection(i),
+                                    time_[i], distance_[i],
+                                    energy_[i-1], target_hashes_[i]);
             }
         }
     }
@@ -407,17 +464,15 @@ std::vector<StochasticLoss> Secondaries::GetStochasticLosses(const Geometry& geo
 
 std::vector<StochasticLoss> Secondaries::GetStochasticLosses(const InteractionType& type) const
 {
-    assert(track_.size() == types_.size());
-
     std::vector<StochasticLoss> losses;
-    for (unsigned int i=1; i<track_.size(); i++) {
+    for (unsigned int i=1; i<size(); i++) {
         auto interaction_type = types_[i];
         if (interaction_type == type) {
             losses.emplace_back(static_cast<int>(interaction_type),
-                                track_[i-1].energy - track_[i].energy,
-                                track_[i].position, track_[i].direction,
-                                track_[i].time, track_[i].propagated_distance,
-                                track_[i-1].energy, target_hashes_[i]);
+                                energy_[i-1] - energy_[i],
+                                GetPosition(i), GetDirection(i),
+                                time_[i], distance_[i],
+                                energy_[i-1], target_hashes_[i]);
         }
     }
     return losses;
@@ -438,16 +493,14 @@ std::vector<StochasticLoss> Secondaries::GetStochasticLosses(
 
 std::vector<ContinuousLoss> Secondaries::GetContinuousLosses() const
 {
-    assert(track_.size() == types_.size());
-
     std::vector<ContinuousLoss> losses;
-    for (unsigned int i=1; i<track_.size(); i++) {
+    for (unsigned int i=1; i<size(); i++) {
         if (types_[i] == InteractionType::ContinuousEnergyLoss) {
-            losses.emplace_back( track_[i-1].energy - track_[i].energy,
-                                 track_[i-1].energy,
-                                 track_[i-1].position, track_[i].position,
-                                 track_[i-1].direction, track_[i].direction,
-                                 track_[i-1].time, track_[i].time);
+            losses.emplace_back( energy_[i-1] - energy_[i],
+                                 energy_[i-1],
+                                 GetPosition(i-1), GetPosition(i),
+                                 GetDirection(i-1), GetDirection(i),
+                                 time_[i-1], time_[i]);
         }
     }
     return losses;
@@ -455,20 +508,18 @@ std::vector<ContinuousLoss> Secondaries::GetContinuousLosses() const
 
 std::vector<ContinuousLoss> Secondaries::GetContinuousLosses(const Geometry& geometry) const
 {
-    assert(track_.size() == types_.size());
-
     //TODO: At the moment, part of the continuous losses may be missing if
     // the track points are not exactly on the geometry border
     std::vector<ContinuousLoss> losses;
-    for (unsigned int i=1; i<track_.size(); i++) {
-        if (geometry.IsInside(track_[i].position, track_[i].direction)) {
+    for (unsigned int i=1; i<size(); i++) {
+        if (geometry.IsInside(GetPosition(i), GetDirection(i))) {
             if (types_[i] == InteractionType::ContinuousEnergyLoss) {
                 losses.emplace_back(
-                        track_[i-1].energy - track_[i].energy,
-                        track_[i-1].energy,
-                        track_[i-1].position, track_[i].position,
-                        track_[i-1].direction, track_[i].direction,
-                        track_[i-1].time, track_[i].time);
+                        energy_[i-1] - energy_[i],
+                        energy_[i-1],
+                        GetPosition(i-1), GetPosition(i),
+                        GetDirection(i-1), GetDirection(i),
+                        time_[i-1], time_[i]);
             }
         }
     }
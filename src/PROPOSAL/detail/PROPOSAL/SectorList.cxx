@@ -0,0 +1,46 @@
+#include "PROPOSAL/SectorList.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/math/Cartesian3D.h"
+
+#include <algorithm>
+
+using namespace PROPOSAL;
+using std::get;
+
+SectorList::SectorList(std::vector<Sector> sectors)
+    : sectors_(std::move(sectors))
+{
+    auto geometries = std::vector<std::shared_ptr<const Geometry>>();
+    geometries.reserve(sectors_.size());
+    for (auto& sector : sectors_)
+        geometries.push_back(get<0>(sector));
+    index_ = BoundingVolumeHierarchy(geometries);
+}
+
+const Sector& SectorList::GetCurrentSector(
+    const Vector3D& position, const Vector3D& direction) const
+{
+    auto sector_idx = index_.GetContainingGeometry(position, direction);
+
+    if (sector_idx < 0) {
+        auto cartesian_position = Cartesian3D(position);
+        Logging::Get("proposal.propagator")->critical("No sector defined at particle position {}, {}, {}.",
+                                                      cartesian_position.GetX(),
+                                                      cartesian_position.GetY(),
+                                                      cartesian_position.GetZ());
+        throw std::out_of_range("No sector defined at particle position.");
+    }
+
+    return sectors_[sector_idx];
+}
+
+double SectorList::DistanceToBorder(const Vector3D& position,
+    const Vector3D& direction, const Geometry& current_geometry) const
+{
+    auto distance_border
+        = current_geometry.DistanceToBorder(position, direction).first;
+    auto distance_higher_hierarchy = index_.DistanceToBorder(
+        position, direction, current_geometry.GetHierarchy());
+    return std::min(distance_border, distance_higher_hierarchy);
+}
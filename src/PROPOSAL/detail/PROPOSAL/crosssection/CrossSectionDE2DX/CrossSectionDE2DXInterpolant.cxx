@@ -1,18 +1,16 @@
 
 #include "PROPOSAL/crosssection/CrossSectionDE2DX/CrossSectionDE2DXInterpolant.h"
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/methods.h"
 
 using namespace PROPOSAL;
 
-std::string CrossSectionDE2DXInterpolant::gen_path() const
+std::string CrossSectionDE2DXInterpolant::gen_name(size_t hash) const
 {
-    return std::string(InterpolationSettings::TABLES_PATH);
-}
-
-std::string CrossSectionDE2DXInterpolant::gen_name() const
-{
-    return std::string("de2dx_") + std::to_string(GetHash())
+    return std::string("de2dx_") + std::to_string(hash)
         + std::string(".dat");
 }
 
@@ -22,9 +20,38 @@ size_t CrossSectionDE2DXInterpolant::gen_hash(size_t hash) const {
                  InterpolationSettings::UPPER_ENERGY_LIM);
     return hash;
 }
+
+CrossSectionDE2DXInterpolant::table_t CrossSectionDE2DXInterpolant::build_table(
+    std::shared_ptr<CrossSectionDE2DXIntegral> de2dx, double lower_lim) const
+{
+    auto f = [de2dx](double E) { return de2dx->Calculate(E); };
+    auto ax = AxisBuilderDE2DX(lower_lim);
+    ax.refine_definition_range(f);
+
+    return table_t(ax.GetLow(), ax.GetUp(), ax.GetNodes(), GetHash(),
+        [this, f](table_t::Segment segment) {
+            auto create = [f = NodeRefinement::StoreValues(f)](
+                              table_t::Segment const& segment) {
+                auto def = cubic_splines::CubicSplines<double>::Definition();
+                def.f = f;
+                def.f_trafo
+                    = std::make_unique<cubic_splines::ExpAxis<double>>(1., 0.);
+                def.axis = std::make_unique<cubic_splines::ExpAxis<double>>(
+                    segment.low, segment.up, segment.nodes);
+                return def;
+            };
+            segment = NodeRefinement::Refine(
+                segment, create, [this](size_t hash) { return gen_name(hash); });
+            auto name = gen_name(segment.hash);
+            return InterpolantRegistry::Get<interpolant_t>(name, [&]() {
+                return TableArchive::Create<interpolant_t>(create(segment), name);
+            });
+        });
+}
+
 double CrossSectionDE2DXInterpolant::Calculate(double energy) const
 {
     if (energy < lower_energy_lim)
         return 0.;
-    return interpolant.evaluate(energy);
+    return interpolant.At(energy)->evaluate(energy);
 }
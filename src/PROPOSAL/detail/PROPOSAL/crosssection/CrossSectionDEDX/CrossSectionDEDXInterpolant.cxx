@@ -1,17 +1,20 @@
 #include "PROPOSAL/crosssection/CrossSectionDEDX/CrossSectionDEDXInterpolant.h"
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/methods.h"
 
 using namespace PROPOSAL;
 
 std::string CrossSectionDEDXInterpolant::gen_path() const
 {
-    return std::string(InterpolationSettings::TABLES_PATH);
+    return TableArchive::GetTablesPath();
 }
 
-std::string CrossSectionDEDXInterpolant::gen_name() const
+std::string CrossSectionDEDXInterpolant::gen_name(size_t hash) const
 {
-    return std::string("dedx_") + std::to_string(GetHash())
+    return std::string("dedx_") + std::to_string(hash)
         + std::string(".dat");
 }
 
@@ -22,9 +25,38 @@ size_t CrossSectionDEDXInterpolant::gen_hash(size_t hash) const {
     return hash;
 }
 
+CrossSectionDEDXInterpolant::table_t CrossSectionDEDXInterpolant::build_table(
+    std::shared_ptr<CrossSectionDEDXIntegral> dedx, double lower_lim) const
+{
+    auto f = [dedx](double E) { return dedx->Calculate(E); };
+    auto ax = AxisBuilderDEDX(lower_lim);
+    ax.refine_definition_range(f);
+
+    return table_t(ax.GetLow(), ax.GetUp(), ax.GetNodes(), GetHash(),
+        [this, f](table_t::Segment segment) {
+            auto create = [f = NodeRefinement::StoreValues(f)](
+                              table_t::Segment const& segment) {
+                auto def = cubic_splines::CubicSplines<double>::Definition();
+                def.f_trafo
+                    = std::make_unique<cubic_splines::ExpAxis<double>>(1., 0.);
+                def.f = f;
+                def.axis = std::make_unique<cubic_splines::ExpAxis<double>>(
+                    segment.low, segment.up, segment.nodes);
+                return def;
+            };
+            segment = NodeRefinement::Refine(
+                segment, create, [this](size_t hash) { return gen_name(hash); });
+            auto name = gen_name(segment.hash);
+            LogTableCreation(gen_path(), name);
+            return InterpolantRegistry::Get<interpolant_t>(name, [&]() {
+                return TableArchive::Create<interpolant_t>(create(segment), name);
+            });
+        });
+}
+
 double CrossSectionDEDXInterpolant::Calculate(double E) const
 {
     if (E < lower_energy_lim)
         return 0.;
-    return interpolant.evaluate(E);
+    return interpolant.At(E)->evaluate(E);
 }
@@ -1,11 +1,17 @@
 #define CROSSSECTIONDNDXINTERPOLANT_INSTANTIATION
 #include "PROPOSAL/crosssection/CrossSectionDNDX/CrossSectionDNDXInterpolant.h"
 #include "PROPOSAL/methods.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/Logging.h"
+#include "PROPOSAL/PropagationStatistics.h"
 #include "PROPOSAL/math/MathMethods.h"
 #include "PROPOSAL/particle/Particle.h"
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 
 #include "CubicInterpolation/Axis.h"
 #include "CubicInterpolation/FindParameter.hpp"
@@ -41,14 +47,65 @@ namespace PROPOSAL {
     }
 }
 
+namespace {
+// node of the axis at position x, or -1 if x is not a node
+long node_index(cubic_splines::Axis<double> const& axis, double x)
+{
+    auto t = axis.transform(x);
+    auto i = std::lround(t);
+    if (i < 0 || i >= static_cast<long>(axis.GetNodes())
+        || std::abs(t - i) > 1e-6)
+        return -1;
+    return i;
+}
+} // namespace
+
+std::function<double(double, double)> detail::evaluate_nodes_concurrently(
+    cubic_splines::Axis<double> const& axis_0,
+    cubic_splines::Axis<double> const& axis_1,
+    std::function<double(double, double)> f)
+{
+    struct Nodes {
+        std::once_flag evaluated;
+        std::vector<double> values;
+    };
+    auto nodes = std::make_shared<Nodes>();
+
+    // the axes are owned by the definition, which is kept by the interpolant
+    return [nodes, axis_0 = &axis_0, axis_1 = &axis_1, f](
+               double x_0, double x_1) {
+        auto i = node_index(*axis_0, x_0);
+        auto j = node_index(*axis_1, x_1);
+        if (i < 0 || j < 0)
+            return f(x_0, x_1);
+
+        auto n_1 = axis_1->GetNodes();
+        std::call_once(nodes->evaluated, [&]() {
+            auto n = axis_0->GetNodes() * n_1;
+            nodes->values.resize(n);
+            Helper::ParallelFor(n, [&](size_t k) {
+                nodes->values[k] = f(axis_0->back_transform(k / n_1),
+                    axis_1->back_transform(k % n_1));
+            });
+        });
+        return nodes->values[i * n_1 + j];
+    };
+}
+
 std::string CrossSectionDNDXInterpolant::gen_path() const
 {
-    return std::string(InterpolationSettings::TABLES_PATH);
+    return TableArchive::GetTablesPath();
 }
 
-std::string CrossSectionDNDXInterpolant::gen_name() const
+std::string CrossSectionDNDXInterpolant::gen_name(size_t hash) const
 {
-    return std::string("dndx_") + std::to_string(GetHash())
+    return std::string("dndx_") + std::to_string(hash)
+        + std::string(".dat");
+}
+
+std::string CrossSectionDNDXInterpolant::gen_inverse_name(size_t hash) const
+{
+    return std::string("dndx_inverse_") + std::to_string(hash)
         + std::string(".dat");
 }
 
@@ -60,11 +117,86 @@ size_t CrossSectionDNDXInterpolant::gen_hash(size_t hash) const {
     return hash;
 }
 
+CrossSectionDNDXInterpolant::table_t CrossSectionDNDXInterpolant::build_table(
+    integrand_t integrand, double lower_lim) const
+{
+    auto dndx = integrand.first;
+    auto energy_lim = AxisBuilderDNDX::energy_limits();
+    energy_lim.low = lower_lim;
+    energy_lim.up = InterpolationSettings::UPPER_ENERGY_LIM;
+    energy_lim.nodes = InterpolationSettings::NODES_DNDX_E;
+    auto energy_lim_refined = AxisBuilderDNDX::refine_definition_range(
+        energy_lim, [dndx](double E) { return dndx->Calculate(E); });
+
+    auto f = integrand.second;
+    return table_t(energy_lim_refined.low, energy_lim_refined.up,
+        energy_lim_refined.nodes, GetHash(),
+        [this, f](table_t::Segment segment) {
+            auto create = [f = NodeRefinement::StoreValues(f)](
+                              table_t::Segment const& segment) {
+                auto v_lim = AxisBuilderDNDX::v_limits { 0, 1,
+                    InterpolationSettings::NODES_DNDX_V };
+                auto energy_lim = AxisBuilderDNDX::energy_limits { segment.low,
+                    segment.up, segment.nodes };
+                auto def = cubic_splines::BicubicSplines<double>::Definition();
+                def.axis = AxisBuilderDNDX::Create(v_lim, energy_lim);
+                def.f = detail::evaluate_nodes_concurrently(
+                    *def.axis[0], *def.axis[1], f);
+                def.approx_derivates = true;
+                return def;
+            };
+            segment = NodeRefinement::Refine(
+                segment, create, [this](size_t hash) { return gen_name(hash); });
+            auto name = gen_name(segment.hash);
+            LogTableCreation(gen_path(), name);
+            auto tables = Tables();
+            tables.dndx = InterpolantRegistry::Get<interpolant_t>(name, [&]() {
+                return TableArchive::Create<interpolant_t>(create(segment), name);
+            });
+            if (!InterpolationSettings::DNDX_INVERSE_TABLES)
+                return tables;
+
+            // the inverse has the energy nodes of the refined segment, so it
+            // is named after its hash
+            auto inverse_name = gen_inverse_name(segment.hash);
+            LogTableCreation(gen_path(), inverse_name);
+            tables.inverse = InterpolantRegistry::Get<interpolant_t>(
+                inverse_name, [&]() {
+                    auto def = cubic_splines::BicubicSplines<double>::Definition();
+                    def.axis = AxisBuilderDNDX::Create(
+                        AxisBuilderDNDX::v_limits { 0, 1,
+                            InterpolationSettings::NODES_DNDX_V },
+                        AxisBuilderDNDX::energy_limits {
+                            segment.low, segment.up, segment.nodes });
+                    def.f = detail::evaluate_nodes_concurrently(*def.axis[0],
+                        *def.axis[1], [dndx = tables.dndx](double E, double fraction) {
+                            auto dNdx = [&dndx, E](double vbar) {
+                                return dndx->evaluate(std::array<double, 2> { E, vbar });
+                            };
+                            auto total = dNdx(1.);
+                            if (!(total > 0) || fraction <= 0)
+                                return 0.;
+                            if (fraction >= 1)
+                                return 1.;
+                            auto interval = Bisection(
+                                [&](double vbar) { return dNdx(vbar) - fraction * total; },
+                                0., 1., 1e-10, 100);
+                            return (interval.first + interval.second) / 2.;
+                        });
+                    def.approx_derivates = true;
+                    return TableArchive::Create<interpolant_t>(
+                        std::move(def), inverse_name);
+                });
+            return tables;
+        });
+}
+
 double CrossSectionDNDXInterpolant::evaluate_interpolant(double E, double vbar)
 {
     if (E < lower_energy_lim)
         return 0.;
-    auto dNdx = interpolant.evaluate(std::array<double, 2> { E, vbar });
+    auto dNdx
+        = interpolant.At(E).dndx->evaluate(std::array<double, 2> { E, vbar });
     if (dNdx < 0) {
         auto inter_name = Type_Interaction_Name_Map.at(type_id);
         logger->warn("Negative dNdx value for E = {:.4f} MeV, vbar = {:.4f} "
@@ -93,21 +225,36 @@ double CrossSectionDNDXInterpolant::GetUpperLimit(double energy, double rate)
     if (energy < lower_energy_lim)
         throw std::invalid_argument("no dNdx for this energy defined.");
     auto lim = GetIntegrationLimits(energy);
+    auto& tables = interpolant.At(energy);
 
     auto initial_guess = cubic_splines::ParameterGuess<std::array<double, 2>>();
     initial_guess.x = { energy, NAN };
     initial_guess.n = 1;
+    if (tables.inverse) {
+        // the inverse is only accurate to about a percent of v, so it is used
+        // as the initial guess of the newton raphson method on the dNdx table
+        auto total = tables.dndx->evaluate(std::array<double, 2> { energy, 1. });
+        if (total > 0) {
+            auto fraction = std::min(std::max(rate / total, 0.), 1.);
+            auto v = tables.inverse->evaluate(
+                std::array<double, 2> { energy, fraction });
+            initial_guess.x[1] = std::min(std::max(v, 0.), 1.);
+        }
+    }
+
+    auto& table = *tables.dndx;
     double v;
     try {
-        v = cubic_splines::find_parameter(interpolant, rate, initial_guess);
+        v = cubic_splines::find_parameter(table, rate, initial_guess);
     } catch (std::runtime_error&) {
+        InterpolantFallbacks::ThisThread().dndx_bisection++;
         Logging::Get("proposal.UtilityInterpolant")->warn(
                 "Newton-Raphson iteration in "
                 "CrossSectionDNDXInterpolant::GetUpperLimit failed. Try solving"
                 " using bisection method.");
 
-        auto f = [this, &rate, &energy](double val) {
-            return interpolant.evaluate(
+        auto f = [&table, &rate, &energy](double val) {
+            return table.evaluate(
                     std::array<double, 2> { energy, val }) - rate;
         };
         // v is evaluated in transformed space!
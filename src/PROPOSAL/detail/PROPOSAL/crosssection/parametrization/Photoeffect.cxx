@@ -45,6 +45,8 @@ double crosssection::Photoeffect::PhotonAtomCrossSection(double energy, const Co
 double crosssection::Photoeffect::CalculatedNdx(
         double energy, size_t comp_hash, const ParticleDef&, const Medium& m, cut_ptr) {
         auto comp = Component::GetComponentForHash(comp_hash);
+        if (energy <= GetCutOff(comp))
+            return 0.;
         auto weight = detail::weight_component(m, comp);
         return NA / comp.GetAtomicNum() * PhotonAtomCrossSection(energy, comp) / weight;
 }
@@ -96,7 +96,7 @@ double LeptonicDecayChannelApprox::FindRoot(double min, double parent_mass, doub
 }
 
 // ------------------------------------------------------------------------- //
-std::vector<ParticleState> LeptonicDecayChannelApprox::Decay(const ParticleDef& p_def, const ParticleState& p_condition)
+std::vector<ParticleState> LeptonicDecayChannelApprox::Decay(const ParticleDef& p_def, const ParticleState& p_condition, std::function<double()> rnd)
 {
     assert (p_condition.direction.magnitude() > 0);
     // Sample energy from decay rate
@@ -105,7 +105,7 @@ std::vector<ParticleState> LeptonicDecayChannelApprox::Decay(const ParticleDef&
 
     double f_min      = DecayRate(x_min, p_def.mass, emax, 0.0);
     double f_max      = DecayRate(1.0, p_def.mass, emax, 0.0);
-    double right_side = f_min + (f_max - f_min) * RandomGenerator::Get().RandomDouble();
+    double right_side = f_min + (f_max - f_min) * rnd();
 
     double find_root = FindRoot(x_min, p_def.mass, emax, right_side);
 
@@ -116,7 +116,7 @@ std::vector<ParticleState> LeptonicDecayChannelApprox::Decay(const ParticleDef&
     // Sample directions For the massive letpon
     ParticleState massive_lepton((ParticleType)massive_lepton_.particle_type,
                                  p_condition.position,
-                                 GenerateRandomDirection(),
+                                 GenerateRandomDirection(rnd),
                                  lepton_energy,
                                  p_condition.time,
                                  0.);
@@ -127,7 +127,7 @@ std::vector<ParticleState> LeptonicDecayChannelApprox::Decay(const ParticleDef&
     double momentum_neutrinos = 0.5 * virtual_mass;
 
 
-    auto direction = GenerateRandomDirection();
+    auto direction = GenerateRandomDirection(rnd);
 
     ParticleState neutrino((ParticleType)neutrino_.particle_type,
                            p_condition.position,
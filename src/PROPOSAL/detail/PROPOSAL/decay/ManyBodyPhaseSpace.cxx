@@ -31,13 +31,13 @@ ManyBodyPhaseSpace::ManyBodyPhaseSpace(std::vector<std::shared_ptr<const Particl
     {
         matrix_element_ = ManyBodyPhaseSpace::DefaultEvaluate;
         use_default_matrix_element_ = true;
-        estimate_ = std::bind(&ManyBodyPhaseSpace::EstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2);
+        estimate_ = std::bind(&ManyBodyPhaseSpace::EstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
     }
     else
     {
         matrix_element_ = me;
         use_default_matrix_element_ = false;
-        estimate_ = std::bind(&ManyBodyPhaseSpace::SampleEstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2);
+        estimate_ = std::bind(&ManyBodyPhaseSpace::SampleEstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
     }
     for (const auto& i : daughters) {
 
@@ -61,11 +61,11 @@ ManyBodyPhaseSpace::ManyBodyPhaseSpace(const ManyBodyPhaseSpace& mode)
 {
     if (use_default_matrix_element_)
     {
-        estimate_ = std::bind(&ManyBodyPhaseSpace::EstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2);
+        estimate_ = std::bind(&ManyBodyPhaseSpace::EstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
     }
     else
     {
-        estimate_ = std::bind(&ManyBodyPhaseSpace::SampleEstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2);
+        estimate_ = std::bind(&ManyBodyPhaseSpace::SampleEstimateMaxWeight, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
     }
 
 }
@@ -103,7 +103,7 @@ bool ManyBodyPhaseSpace::compare(const DecayChannel& channel) const
 }
 
 // ------------------------------------------------------------------------- //
-std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, const ParticleState& p_condition)
+std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, const ParticleState& p_condition, std::function<double()> rnd)
 {
     // Create vector for decay products
     std::vector<ParticleState> products;
@@ -113,7 +113,7 @@ std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, c
     }
 
     // prefactor for the phase space density
-    PhaseSpaceParameters params = GetPhaseSpaceParams(p_def);
+    PhaseSpaceParameters params = GetPhaseSpaceParams(p_def, rnd);
     PhaseSpaceKinematics kinematics;
 
     if (uniform_)
@@ -123,10 +123,10 @@ std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, c
         do
         {
             // precalculated kinematics
-            kinematics = CalculateKinematics(params.normalization, p_def.mass);
-            GenerateEvent(products, kinematics);
+            kinematics = CalculateKinematics(params.normalization, p_def.mass, rnd);
+            GenerateEvent(products, kinematics, rnd);
             // sample product states with rejection sampling
-            weight_ref = params.weight_min + RandomGenerator::Get().RandomDouble() * (params.weight_max - params.weight_min);
+            weight_ref = params.weight_min + rnd() * (params.weight_max - params.weight_min);
             weight_sample = kinematics.weight * matrix_element_(p_condition, products);
 
         } while(weight_ref > weight_sample);
@@ -134,8 +134,8 @@ std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, c
     else
     {
         // precalculated kinematics
-        kinematics = CalculateKinematics(params.normalization, p_def.mass);
-        GenerateEvent(products, kinematics);
+        kinematics = CalculateKinematics(params.normalization, p_def.mass, rnd);
+        GenerateEvent(products, kinematics, rnd);
     }
 
     // Get Momentum is not defined for pseudo particle decay, so it must be
@@ -148,10 +148,10 @@ std::vector<ParticleState> ManyBodyPhaseSpace::Decay(const ParticleDef& p_def, c
 }
 
 // ------------------------------------------------------------------------- //
-void ManyBodyPhaseSpace::GenerateEvent(std::vector<ParticleState>& products, const PhaseSpaceKinematics& kinematics)
+void ManyBodyPhaseSpace::GenerateEvent(std::vector<ParticleState>& products, const PhaseSpaceKinematics& kinematics, std::function<double()> rnd)
 {
     // Calculate first momentum in R2
-    Cartesian3D direction = GenerateRandomDirection();
+    Cartesian3D direction = GenerateRandomDirection(rnd);
 
     products[1].direction = direction;
     products[1].SetMomentum(kinematics.momenta[0]);
@@ -165,7 +165,7 @@ void ManyBodyPhaseSpace::GenerateEvent(std::vector<ParticleState>& products, con
     {
         double momentum = kinematics.momenta[i-1];
 
-        products[i].direction = GenerateRandomDirection();
+        products[i].direction = GenerateRandomDirection(rnd);
         products[i].SetMomentum(momentum);
 
         // Boost previous particles to new frame
@@ -199,8 +199,10 @@ double ManyBodyPhaseSpace::Evaluate(const ParticleState& p_condition, const std:
 }
 
 // ------------------------------------------------------------------------- //
-ManyBodyPhaseSpace::PhaseSpaceParameters ManyBodyPhaseSpace::GetPhaseSpaceParams(const ParticleDef& parent_def)
+ManyBodyPhaseSpace::PhaseSpaceParameters ManyBodyPhaseSpace::GetPhaseSpaceParams(const ParticleDef& parent_def, std::function<double()> rnd)
 {
+    std::lock_guard<std::mutex> lock(parameter_map_mutex_);
+
     ParameterMap::iterator it = parameter_map_.find(parent_def);
 
     if (it != parameter_map_.end())
@@ -211,7 +213,7 @@ ManyBodyPhaseSpace::PhaseSpaceParameters ManyBodyPhaseSpace::GetPhaseSpaceParams
         PhaseSpaceParameters params;
 
         params.normalization = CalculateNormalization(parent_def.mass);
-        estimate_(params, parent_def);
+        estimate_(params, parent_def, rnd);
 
         parameter_map_[parent_def] = params;
 
@@ -231,7 +233,7 @@ double ManyBodyPhaseSpace::CalculateNormalization(double parent_mass)
 }
 
 // ------------------------------------------------------------------------- //
-void ManyBodyPhaseSpace::EstimateMaxWeight(PhaseSpaceParameters& params, const ParticleDef& parent_def)
+void ManyBodyPhaseSpace::EstimateMaxWeight(PhaseSpaceParameters& params, const ParticleDef& parent_def, std::function<double()>)
 {
     double weight = 1.0;
     double E_max = parent_def.mass - sum_daughter_masses_ + daughter_masses_[0];
@@ -249,7 +251,7 @@ void ManyBodyPhaseSpace::EstimateMaxWeight(PhaseSpaceParameters& params, const P
 }
 
 // ------------------------------------------------------------------------- //
-void ManyBodyPhaseSpace::SampleEstimateMaxWeight(PhaseSpaceParameters& params, const ParticleDef& parent_def)
+void ManyBodyPhaseSpace::SampleEstimateMaxWeight(PhaseSpaceParameters& params, const ParticleDef& parent_def, std::function<double()> rnd)
 {
     // Create vector for decay products
     std::vector<ParticleState> products;
@@ -265,16 +267,16 @@ void ManyBodyPhaseSpace::SampleEstimateMaxWeight(PhaseSpaceParameters& params, c
     particle.energy = parent_def.mass;
 
     // initialization of weights
-    PhaseSpaceKinematics kinematics = CalculateKinematics(params.normalization, parent_def.mass);
-    GenerateEvent(products, kinematics);
+    PhaseSpaceKinematics kinematics = CalculateKinematics(params.normalization, parent_def.mass, rnd);
+    GenerateEvent(products, kinematics, rnd);
     double result = kinematics.weight * matrix_element_(particle, products);
     params.weight_min = result;
     params.weight_max = result;
 
     for (int i = 1; i < broad_phase_statistic_; ++i)
     {
-        kinematics = CalculateKinematics(params.normalization, parent_def.mass);
-        GenerateEvent(products, kinematics);
+        kinematics = CalculateKinematics(params.normalization, parent_def.mass, rnd);
+        GenerateEvent(products, kinematics, rnd);
         result = kinematics.weight * matrix_element_(particle, products);
 
         if (result < params.weight_min)
@@ -290,7 +292,7 @@ void ManyBodyPhaseSpace::SampleEstimateMaxWeight(PhaseSpaceParameters& params, c
 }
 
 // ------------------------------------------------------------------------- //
-ManyBodyPhaseSpace::PhaseSpaceKinematics ManyBodyPhaseSpace::CalculateKinematics(double normalization, double parent_mass)
+ManyBodyPhaseSpace::PhaseSpaceKinematics ManyBodyPhaseSpace::CalculateKinematics(double normalization, double parent_mass, std::function<double()> rnd)
 {
     PhaseSpaceKinematics kinematics;
 
@@ -302,7 +304,7 @@ ManyBodyPhaseSpace::PhaseSpaceKinematics ManyBodyPhaseSpace::CalculateKinematics
 
     for (unsigned int i = 0; i < daughter_masses_.size() - 2; ++i)
     {
-        randoms.push_back(RandomGenerator::Get().RandomDouble());
+        randoms.push_back(rnd());
     }
 
     randoms.push_back(1.0);
@@ -0,0 +1,236 @@
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+
+using namespace PROPOSAL;
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    std::vector<std::shared_ptr<const Geometry>> geometries)
+    : geometries_(std::move(geometries))
+{
+    boxes_.reserve(geometries_.size());
+    for (auto& geometry : geometries_) {
+        auto corners = geometry->GetBoundingBox();
+        auto lower = corners.first.GetCartesianCoordinates();
+        auto upper = corners.second.GetCartesianCoordinates();
+        auto bounded = true;
+        for (size_t k = 0; k < 3; ++k)
+            bounded = bounded && std::isfinite(lower[k])
+                && std::isfinite(upper[k]);
+        if (!bounded)
+            unbounded_.push_back(boxes_.size());
+        else
+            items_.push_back(boxes_.size());
+
+        // Geometries treat positions closer than GEOMETRY_PRECISION to their
+        // border as inside, and positions on a border are only accurate up to
+        // rounding. The boxes are padded so that they never reject a
+        // position the geometry itself would accept.
+        for (size_t k = 0; k < 3; ++k) {
+            auto pad = GEOMETRY_PRECISION
+                + 1e-9 * std::max(std::abs(lower[k]), std::abs(upper[k]));
+            lower[k] -= pad;
+            upper[k] += pad;
+        }
+        boxes_.push_back({ lower, upper });
+    }
+
+    if (!items_.empty()) {
+        nodes_.reserve(2 * items_.size());
+        Build(0, items_.size());
+    }
+}
+
+int BoundingVolumeHierarchy::Build(size_t first, size_t last)
+{
+    auto node = Node();
+    node.box = boxes_[items_[first]];
+    node.max_hierarchy = 0;
+    node.left = -1;
+    node.right = -1;
+    node.first = first;
+    node.count = last - first;
+
+    auto centroid_lower = std::array<double, 3> { INF, INF, INF };
+    auto centroid_upper = std::array<double, 3> { -INF, -INF, -INF };
+    for (auto i = first; i < last; ++i) {
+        auto& box = boxes_[items_[i]];
+        for (size_t k = 0; k < 3; ++k) {
+            node.box.lower[k] = std::min(node.box.lower[k], box.lower[k]);
+            node.box.upper[k] = std::max(node.box.upper[k], box.upper[k]);
+            auto centroid = 0.5 * (box.lower[k] + box.upper[k]);
+            centroid_lower[k] = std::min(centroid_lower[k], centroid);
+            centroid_upper[k] = std::max(centroid_upper[k], centroid);
+        }
+        node.max_hierarchy = std::max(
+            node.max_hierarchy, geometries_[items_[i]]->GetHierarchy());
+    }
+
+    auto index = static_cast<int>(nodes_.size());
+    nodes_.push_back(node);
+
+    if (node.count <= max_leaf_size)
+        return index;
+
+    // split at the median of the box centres along the axis of largest spread
+    size_t axis = 0;
+    for (size_t k = 1; k < 3; ++k) {
+        if (centroid_upper[k] - centroid_lower[k]
+            > centroid_upper[axis] - centroid_lower[axis])
+            axis = k;
+    }
+    auto middle = first + node.count / 2;
+    std::nth_element(items_.begin() + first, items_.begin() + middle,
+        items_.begin() + last, [this, axis](size_t a, size_t b) {
+            return boxes_[a].lower[axis] + boxes_[a].upper[axis]
+                < boxes_[b].lower[axis] + boxes_[b].upper[axis];
+        });
+
+    auto left = Build(first, middle);
+    auto right = Build(middle, last);
+    nodes_[index].left = left;
+    nodes_[index].right = right;
+    nodes_[index].count = 0;
+    return index;
+}
+
+bool BoundingVolumeHierarchy::Contains(
+    const AABB& box, const std::array<double, 3>& position)
+{
+    for (size_t k = 0; k < 3; ++k) {
+        if (position[k] < box.lower[k] || position[k] > box.upper[k])
+            return false;
+    }
+    return true;
+}
+
+double BoundingVolumeHierarchy::Intersect(const AABB& box,
+    const std::array<double, 3>& position,
+    const std::array<double, 3>& direction)
+{
+    // slab test, returns the distance at which the ray enters the box (zero
+    // if it starts inside) or INF if the box is missed
+    double t_enter = 0.;
+    double t_exit = INF;
+    for (size_t k = 0; k < 3; ++k) {
+        if (direction[k] == 0.) {
+            if (position[k] < box.lower[k] || position[k] > box.upper[k])
+                return INF;
+            continue;
+        }
+        auto t_1 = (box.lower[k] - position[k]) / direction[k];
+        auto t_2 = (box.upper[k] - position[k]) / direction[k];
+        if (t_1 > t_2)
+            std::swap(t_1, t_2);
+        t_enter = std::max(t_enter, t_1);
+        t_exit = std::min(t_exit, t_2);
+        if (t_enter > t_exit)
+            return INF;
+    }
+    return t_enter;
+}
+
+int BoundingVolumeHierarchy::GetContainingGeometry(
+    const Vector3D& position, const Vector3D& direction) const
+{
+    auto pos = position.GetCartesianCoordinates();
+    int found = -1;
+    unsigned int found_hierarchy = 0;
+    auto test = [&](size_t i) {
+        auto idx = static_cast<int>(i);
+        auto hierarchy = geometries_[idx]->GetHierarchy();
+        if (found >= 0
+            && (hierarchy < found_hierarchy
+                || (hierarchy == found_hierarchy && idx > found)))
+            return;
+        if (geometries_[idx]->IsInside(position, direction)) {
+            found = idx;
+            found_hierarchy = hierarchy;
+        }
+    };
+
+    for (auto i : unbounded_)
+        test(i);
+    if (nodes_.empty())
+        return found;
+
+    // the tree is balanced, so its depth is far below the stack size
+    std::array<int, 128> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        auto& node = nodes_[stack[--stack_size]];
+
+        if (found >= 0 && node.max_hierarchy < found_hierarchy)
+            continue;
+        if (!Contains(node.box, pos))
+            continue;
+
+        if (node.count == 0) {
+            stack[stack_size++] = node.left;
+            stack[stack_size++] = node.right;
+            continue;
+        }
+
+        for (auto i = node.first; i < node.first + node.count; ++i) {
+            if (Contains(boxes_[items_[i]], pos))
+                test(items_[i]);
+        }
+    }
+    return found;
+}
+
+double BoundingVolumeHierarchy::DistanceToBorder(const Vector3D& position,
+    const Vector3D& direction, unsigned int min_hierarchy) const
+{
+    auto distance = INF;
+    for (auto i : unbounded_) {
+        if (geometries_[i]->GetHierarchy() <= min_hierarchy)
+            continue;
+        auto tmp_distance
+            = geometries_[i]->DistanceToBorder(position, direction).first;
+        if (tmp_distance >= 0)
+            distance = std::min(distance, tmp_distance);
+    }
+    if (nodes_.empty())
+        return distance;
+
+    auto pos = position.GetCartesianCoordinates();
+    auto dir = direction.GetCartesianCoordinates();
+
+    std::array<int, 128> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        auto& node = nodes_[stack[--stack_size]];
+
+        if (node.max_hierarchy <= min_hierarchy)
+            continue;
+        if (Intersect(node.box, pos, dir) >= distance)
+            continue;
+
+        if (node.count == 0) {
+            stack[stack_size++] = node.left;
+            stack[stack_size++] = node.right;
+            continue;
+        }
+
+        for (auto i = node.first; i < node.first + node.count; ++i) {
+            auto& geometry = geometries_[items_[i]];
+            if (geometry->GetHierarchy() <= min_hierarchy)
+                continue;
+            if (Intersect(boxes_[items_[i]], pos, dir) >= distance)
+                continue;
+            auto tmp_distance
+                = geometry->DistanceToBorder(position, direction).first;
+            if (tmp_distance >= 0)
+                distance = std::min(distance, tmp_distance);
+        }
+    }
+    return distance;
+}
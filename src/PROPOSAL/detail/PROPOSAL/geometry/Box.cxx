@@ -280,3 +280,10 @@ std::pair<double, double> Box::DistanceToBorder(const Vector3D& position, const
 
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+std::pair<Cartesian3D, Cartesian3D> Box::GetBoundingBox() const
+{
+    auto half_width = Cartesian3D(0.5 * x_, 0.5 * y_, 0.5 * z_);
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
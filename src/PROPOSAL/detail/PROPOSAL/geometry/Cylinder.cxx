@@ -518,3 +518,10 @@ std::pair<double, double> Cylinder::DistanceToBorder(const Vector3D& position, c
 
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+std::pair<Cartesian3D, Cartesian3D> Cylinder::GetBoundingBox() const
+{
+    auto half_width = Cartesian3D(radius_, radius_, 0.5 * z_);
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
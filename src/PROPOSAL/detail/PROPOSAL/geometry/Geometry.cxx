@@ -6,6 +6,7 @@
  */
 
 #include <sstream>
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/geometry/Geometry.h"
 
 #include "PROPOSAL/methods.h"
@@ -159,6 +160,13 @@ Geometry::ParticleLocation::Enum Geometry::GetLocation(const Vector3D& position,
         return Geometry::ParticleLocation::BehindGeometry;
 }
 
+// ------------------------------------------------------------------------- //
+std::pair<Cartesian3D, Cartesian3D> Geometry::GetBoundingBox() const
+{
+    return std::make_pair(
+        Cartesian3D(-INF, -INF, -INF), Cartesian3D(INF, INF, INF));
+}
+
 // ------------------------------------------------------------------------- //
 double Geometry::DistanceToClosestApproach(const Vector3D& position, const Vector3D& direction) const
 {
@@ -239,3 +239,10 @@ std::pair<double, double> Sphere::DistanceToBorder(const Vector3D& position, con
 
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+std::pair<Cartesian3D, Cartesian3D> Sphere::GetBoundingBox() const
+{
+    auto half_width = Cartesian3D(radius_, radius_, radius_);
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
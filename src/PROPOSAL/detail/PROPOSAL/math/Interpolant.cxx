@@ -162,10 +162,9 @@ double Interpolant::Interpolate(double x1, double x2)
 
 double Interpolant::InterpolateArray(double x)
 {
-    int i, j, m, start, auxdir;
+    int i, j, m, start, auxdir, starti;
     bool dir;
 
-    reverse_ = false;
     i        = 0;
     j        = max_ - 1;
     dir      = iX_.at(max_ - 1) > iX_.at(0);
@@ -197,8 +196,8 @@ double Interpolant::InterpolateArray(double x)
         auxdir = 0;
     }
 
-    starti_ = i + auxdir;
-    start   = i - (int)(0.5 * (romberg_ - 1 - auxdir));
+    starti = i + auxdir;
+    start  = i - (int)(0.5 * (romberg_ - 1 - auxdir));
 
     if (start < 0)
     {
@@ -210,7 +209,13 @@ double Interpolant::InterpolateArray(double x)
         start = max_ - romberg_;
     }
 
-    return Interpolate(x, start);
+    // the intermediate results are kept per thread instead of in the members,
+    // so the same interpolant can be evaluated concurrently
+    thread_local std::vector<double> c, d;
+    c.resize(romberg_);
+    d.resize(romberg_);
+
+    return Interpolate(x, start, iY_, false, starti, c, d);
 }
 
 //----------------------------------------------------------------------------//
@@ -218,10 +223,9 @@ double Interpolant::InterpolateArray(double x)
 
 double Interpolant::InterpolateArray(double x1, double x2)
 {
-    int i, j, m, start, auxdir, aux, aux2;
+    int i, j, m, start, auxdir, aux, aux2, starti;
     bool dir;
 
-    reverse_ = false;
     i        = 0;
     j        = max_ - 1;
     dir      = iX_.at(max_ - 1) > iX_.at(0);
@@ -253,8 +257,8 @@ double Interpolant::InterpolateArray(double x1, double x2)
         auxdir = 0;
     }
 
-    starti_ = i + auxdir;
-    start   = i - (int)(0.5 * (romberg_ - 1 - auxdir));
+    starti = i + auxdir;
+    start  = i - (int)(0.5 * (romberg_ - 1 - auxdir));
 
     if (start < 0)
     {
@@ -266,9 +270,16 @@ double Interpolant::InterpolateArray(double x1, double x2)
         start = max_ - romberg_;
     }
 
+    // see InterpolateArray(double x), the values of the sampling points are
+    // kept per thread as well
+    thread_local std::vector<double> y, c, d;
+    y.resize(max_);
+    c.resize(romberg_);
+    d.resize(romberg_);
+
     for (i = start; i < start + romberg_; i++)
     {
-        iY_.at(i) = Interpolant_.at(i)->InterpolateArray(x2);
+        y.at(i) = Interpolant_.at(i)->InterpolateArray(x2);
     }
 
     if (!fast_)
@@ -292,7 +303,7 @@ double Interpolant::InterpolateArray(double x1, double x2)
         }
     }
 
-    double result = Interpolate(x1, start);
+    double result = Interpolate(x1, start, y, false, starti, c, d);
 
     return result;
 }
@@ -1725,6 +1736,15 @@ double Interpolant::Get2dFunctionFixedY(double x)
 //----------------------------------------------------------------------------//
 
 double Interpolant::Interpolate(double x, int start)
+{
+    return Interpolate(x, start, iY_, reverse_, starti_, c_, d_);
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+double Interpolant::Interpolate(double x, int start, const std::vector<double>& y,
+    bool reverse, int starti, std::vector<double>& c, std::vector<double>& d)
 {
     int num, i, k;
     bool dd, doLog;
@@ -1735,11 +1755,11 @@ double Interpolant::Interpolate(double x, int start)
 
     if (logSubst_)
     {
-        if (reverse_)
+        if (reverse)
         {
             for (i = 0; i < romberg_; i++)
             {
-                if (iY_.at(start + i) == log_cutoff_)
+                if (y.at(start + i) == log_cutoff_)
                 {
                     doLog = true;
                     break;
@@ -1750,26 +1770,26 @@ double Interpolant::Interpolate(double x, int start)
 
     if (fast_)
     {
-        num = starti_ - start;
+        num = starti - start;
 
-        if (x == iX_.at(starti_))
+        if (x == iX_.at(starti))
         {
-            return iY_.at(starti_);
+            return y.at(starti);
         }
 
         if (doLog)
         {
             for (i = 0; i < romberg_; i++)
             {
-                c_.at(i) = Exp(iY_.at(start + i));
-                d_.at(i) = c_.at(i);
+                c.at(i) = Exp(y.at(start + i));
+                d.at(i) = c.at(i);
             }
         } else
         {
             for (i = 0; i < romberg_; i++)
             {
-                c_.at(i) = iY_.at(start + i);
-                d_.at(i) = c_.at(i);
+                c.at(i) = y.at(start + i);
+                d.at(i) = c.at(i);
             }
         }
     } else
@@ -1783,7 +1803,7 @@ double Interpolant::Interpolate(double x, int start)
 
             if (aux2 == 0)
             {
-                return iY_.at(start + i);
+                return y.at(start + i);
             }
 
             if (aux2 < aux)
@@ -1794,12 +1814,12 @@ double Interpolant::Interpolate(double x, int start)
 
             if (doLog)
             {
-                c_.at(i) = Exp(iY_.at(start + i));
-                d_.at(i) = c_.at(i);
+                c.at(i) = Exp(y.at(start + i));
+                d.at(i) = c.at(i);
             } else
             {
-                c_.at(i) = iY_.at(start + i);
-                d_.at(i) = c_.at(i);
+                c.at(i) = y.at(start + i);
+                d.at(i) = c.at(i);
             }
         }
     }
@@ -1837,7 +1857,7 @@ double Interpolant::Interpolate(double x, int start)
         }
     }
 
-    result = iY_.at(start + num);
+    result = y.at(start + num);
 
     if (doLog)
     {
@@ -1850,37 +1870,37 @@ double Interpolant::Interpolate(double x, int start)
         {
             if (rational_)
             {
-                aux  = c_.at(i + 1) - d_.at(i);
+                aux  = c.at(i + 1) - d.at(i);
                 dx2  = iX_.at(start + i + k) - x;
-                dx1  = d_.at(i) * (iX_.at(start + i) - x) / dx2;
-                aux2 = dx1 - c_.at(i + 1);
+                dx1  = d.at(i) * (iX_.at(start + i) - x) / dx2;
+                aux2 = dx1 - c.at(i + 1);
 
                 if (aux2 != 0)
                 {
                     aux      = aux / aux2;
-                    d_.at(i) = c_.at(i + 1) * aux;
-                    c_.at(i) = dx1 * aux;
+                    d.at(i) = c.at(i + 1) * aux;
+                    c.at(i) = dx1 * aux;
                 } else
                 {
-                    c_.at(i) = 0;
-                    d_.at(i) = 0;
+                    c.at(i) = 0;
+                    d.at(i) = 0;
                 }
             } else
             {
                 dx1  = iX_.at(start + i) - x;
                 dx2  = iX_.at(start + i + k) - x;
-                aux  = c_.at(i + 1) - d_.at(i);
+                aux  = c.at(i + 1) - d.at(i);
                 aux2 = dx1 - dx2;
 
                 if (aux2 != 0)
                 {
                     aux      = aux / aux2;
-                    c_.at(i) = dx1 * aux;
-                    d_.at(i) = dx2 * aux;
+                    c.at(i) = dx1 * aux;
+                    d.at(i) = dx2 * aux;
                 } else
                 {
-                    c_.at(i) = 0;
-                    d_.at(i) = 0;
+                    c.at(i) = 0;
+                    d.at(i) = 0;
                 }
             }
         }
@@ -1897,11 +1917,11 @@ double Interpolant::Interpolate(double x, int start)
 
         if (dd)
         {
-            error = c_.at(num);
+            error = c.at(num);
         } else
         {
             num--;
-            error = d_.at(num);
+            error = d.at(num);
         }
 
         dd = !dd;
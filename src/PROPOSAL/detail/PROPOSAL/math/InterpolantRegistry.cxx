@@ -0,0 +1,72 @@
+#include "PROPOSAL/math/InterpolantRegistry.h"
+
+#include <unordered_map>
+#include <vector>
+
+using namespace PROPOSAL;
+
+struct InterpolantRegistry::State {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Slot>> slots;
+};
+
+InterpolantRegistry::State& InterpolantRegistry::GetState()
+{
+    static State state;
+    return state;
+}
+
+std::shared_ptr<InterpolantRegistry::Slot> InterpolantRegistry::GetSlot(
+    const std::string& name)
+{
+    auto& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto& slot = state.slots[name];
+    if (!slot)
+        slot = std::make_shared<Slot>();
+    return slot;
+}
+
+bool InterpolantRegistry::Contains(const std::string& name)
+{
+    auto& state = GetState();
+    std::shared_ptr<Slot> slot;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.slots.find(name);
+        if (it == state.slots.end())
+            return false;
+        slot = it->second;
+    }
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    return !slot->interpolant.expired();
+}
+
+size_t InterpolantRegistry::size()
+{
+    // the slots are locked one by one after releasing the registry lock,
+    // since a slot is locked while its interpolant is built, which can
+    // request other interpolants
+    auto& state = GetState();
+    auto slots = std::vector<std::shared_ptr<Slot>>();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        slots.reserve(state.slots.size());
+        for (auto& slot : state.slots)
+            slots.push_back(slot.second);
+    }
+    size_t n = 0;
+    for (auto& slot : slots) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (!slot->interpolant.expired())
+            ++n;
+    }
+    return n;
+}
+
+void InterpolantRegistry::Clear()
+{
+    auto& state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.slots.clear();
+}
@@ -0,0 +1,161 @@
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/TableArchive.h"
+#include "PROPOSAL/methods.h"
+
+#include "CubicInterpolation/Interpolant.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+using namespace PROPOSAL;
+
+namespace {
+// Values are stored under the rounded logarithm of the energy, so the nodes
+// of the finer table are found even if they differ from the midpoints of the
+// coarser table by rounding errors.
+long long energy_key(double energy)
+{
+    return std::llround(std::log(energy) * 1e10);
+}
+
+double relative_error(
+    std::vector<double> const& exact, std::vector<double> const& approx)
+{
+    auto scale = 0.;
+    for (auto value : exact)
+        scale = std::max(scale, std::abs(value));
+    auto error = 0.;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        auto reference = std::max(std::abs(exact[i]), 1e-3 * scale);
+        if (reference > 0)
+            error = std::max(error, std::abs(approx[i] - exact[i]) / reference);
+    }
+    return error;
+}
+} // namespace
+
+std::function<double(double)> NodeRefinement::StoreValues(
+    std::function<double(double)> f)
+{
+    struct Values {
+        std::mutex mutex;
+        std::unordered_map<long long, double> values;
+    };
+    auto values = std::make_shared<Values>();
+    return [values, f](double energy) {
+        if (!(energy > 0))
+            return f(energy);
+        auto key = energy_key(energy);
+        {
+            std::lock_guard<std::mutex> lock(values->mutex);
+            auto it = values->values.find(key);
+            if (it != values->values.end())
+                return it->second;
+        }
+        auto value = f(energy);
+        std::lock_guard<std::mutex> lock(values->mutex);
+        values->values.emplace(key, value);
+        return value;
+    };
+}
+
+std::function<double(double, double)> NodeRefinement::StoreValues(
+    std::function<double(double, double)> f)
+{
+    struct Values {
+        std::mutex mutex;
+        std::map<std::pair<long long, double>, double> values;
+    };
+    auto values = std::make_shared<Values>();
+    return [values, f](double energy, double x) {
+        if (!(energy > 0))
+            return f(energy, x);
+        auto key = std::make_pair(energy_key(energy), x);
+        {
+            std::lock_guard<std::mutex> lock(values->mutex);
+            auto it = values->values.find(key);
+            if (it != values->values.end())
+                return it->second;
+        }
+        auto value = f(energy, x);
+        std::lock_guard<std::mutex> lock(values->mutex);
+        values->values.emplace(key, value);
+        return value;
+    };
+}
+
+double NodeRefinement::MidpointError(
+    cubic_splines::CubicSplines<double>::Definition def)
+{
+    auto f = def.f;
+    auto midpoints = std::vector<double>();
+    for (size_t i = 0; i + 1 < def.axis->GetNodes(); ++i)
+        midpoints.push_back(def.axis->back_transform(i + 0.5));
+
+    auto table = cubic_splines::Interpolant<cubic_splines::CubicSplines<double>>(
+        std::move(def), "", "");
+    auto exact = std::vector<double>();
+    auto approx = std::vector<double>();
+    for (auto energy : midpoints) {
+        exact.push_back(f(energy));
+        approx.push_back(table.evaluate(energy));
+    }
+    return relative_error(exact, approx);
+}
+
+double NodeRefinement::MidpointError(
+    cubic_splines::BicubicSplines<double>::Definition def)
+{
+    auto f = def.f;
+    auto points = std::vector<std::array<double, 2>>();
+    for (size_t i = 0; i + 1 < def.axis[0]->GetNodes(); ++i)
+        for (size_t j = 0; j < def.axis[1]->GetNodes(); ++j)
+            points.push_back({ def.axis[0]->back_transform(i + 0.5),
+                def.axis[1]->back_transform(j) });
+
+    auto table
+        = cubic_splines::Interpolant<cubic_splines::BicubicSplines<double>>(
+            std::move(def), "", "");
+    auto exact = std::vector<double>(points.size());
+    Helper::ParallelFor(points.size(), [&](size_t k) {
+        exact[k] = f(points[k][0], points[k][1]);
+    });
+    auto approx = std::vector<double>();
+    for (auto const& point : points)
+        approx.push_back(table.evaluate(point));
+    return relative_error(exact, approx);
+}
+
+std::vector<EnergySegmentation::Segment> NodeRefinement::Candidates(
+    EnergySegmentation::Segment const& segment)
+{
+    auto candidates = std::vector<EnergySegmentation::Segment>();
+    auto nodes = segment.nodes;
+    do {
+        auto candidate = segment;
+        candidate.nodes = nodes;
+        hash_combine(candidate.hash, nodes);
+        candidates.push_back(candidate);
+        nodes = 2 * nodes - 1;
+    } while (nodes <= segment.max_nodes);
+    return candidates;
+}
+
+bool NodeRefinement::IsStored(std::string const& name)
+{
+    if (InterpolantRegistry::Contains(name))
+        return true;
+    if (TableArchive::IsEnabled()) {
+        auto archive = TableArchive::Get();
+        return archive && archive->Find(name);
+    }
+    auto path = TableArchive::GetTablesPath();
+    return !path.empty() && Helper::file_exists(path + "/" + name);
+}
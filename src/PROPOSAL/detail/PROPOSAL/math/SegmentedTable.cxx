@@ -0,0 +1,71 @@
+#include "PROPOSAL/math/SegmentedTable.h"
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/methods.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace PROPOSAL;
+
+EnergySegmentation::EnergySegmentation(
+    double low, double up, unsigned int nodes, size_t hash)
+    : lazy_(InterpolationSettings::LAZY_TABLES
+          && !InterpolationSettings::PRECOMPUTE_LAZY_TABLES)
+{
+    if (!(low < up))
+        throw std::invalid_argument(
+            "Lower limit of a table has to be below its upper limit.");
+    auto tolerance = InterpolationSettings::TABLE_TOLERANCE;
+    if (!InterpolationSettings::LAZY_TABLES && !(tolerance > 0)) {
+        segments_.push_back({ low, up, nodes, hash, 0., nodes });
+        return;
+    }
+
+    auto decades = InterpolationSettings::SEGMENT_DECADES;
+    if (!(decades > 0))
+        throw std::invalid_argument("SEGMENT_DECADES has to be positive.");
+
+    // the edges are placed at fixed energies, so tables with different lower
+    // limits share the edges above them. Edges closer than a tenth of a
+    // segment to the limits are dropped to avoid tiny segments.
+    auto edges = std::vector<double> { low };
+    auto min_width = 0.1 * decades;
+    for (auto k = std::ceil(std::log10(low) / decades);
+         k * decades < std::log10(up); ++k) {
+        auto edge = std::pow(10., k * decades);
+        if (std::log10(edge / edges.back()) > min_width
+            && std::log10(up / edge) > min_width)
+            edges.push_back(edge);
+    }
+    edges.push_back(up);
+
+    auto width = std::log(up / low);
+    for (size_t i = 0; i + 1 < edges.size(); ++i) {
+        auto share = std::log(edges[i + 1] / edges[i]) / width;
+        auto segment_nodes = static_cast<unsigned int>(
+            std::ceil(nodes * share)) + 1;
+        segment_nodes = std::max(segment_nodes, 4u);
+        auto segment_hash = hash;
+        if (tolerance > 0) {
+            // refined starting from a coarse table, the number of nodes is
+            // added to the hash by NodeRefinement
+            hash_combine(segment_hash, edges[i], edges[i + 1], tolerance);
+            segments_.push_back({ edges[i], edges[i + 1], 5, segment_hash,
+                tolerance, std::max(4 * segment_nodes, 17u) });
+        } else {
+            hash_combine(segment_hash, edges[i], edges[i + 1], segment_nodes);
+            segments_.push_back({ edges[i], edges[i + 1], segment_nodes,
+                segment_hash, 0., segment_nodes });
+        }
+    }
+}
+
+size_t EnergySegmentation::Find(double energy) const
+{
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), energy,
+        [](double E, Segment const& segment) { return E < segment.up; });
+    if (it == segments_.end())
+        return segments_.size() - 1;
+    return std::distance(segments_.begin(), it);
+}
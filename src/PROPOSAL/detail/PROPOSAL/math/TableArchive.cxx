@@ -0,0 +1,690 @@
+#include "PROPOSAL/math/TableArchive.h"
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/methods.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace PROPOSAL;
+
+namespace {
+// Layout of an archive: the header, the node values of all tables as
+// doubles and the index with one entry per table. Every entry is followed by
+// the name of the table, padded to a multiple of eight bytes.
+const char archive_magic[8] = { 'P', 'R', 'O', 'P', 'T', 'A', 'B', '\0' };
+const uint32_t archive_version = 2;
+
+const uint32_t has_derivatives = 1;
+const uint32_t single_precision = 2;
+
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t n_tables;
+    uint64_t index_offset;
+};
+
+struct IndexEntry {
+    uint32_t name_length;
+    uint32_t flags;
+    uint64_t nodes[2];
+    uint64_t offset;
+    uint64_t checksum; // of the data of the table
+    double axes[2][2]; // lower and upper limit of the axes
+};
+
+size_t Padded(size_t n) { return (n + 7) / 8 * 8; }
+
+// FNV-1a hash of the data of a table
+uint64_t Checksum(const char* data, size_t n)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < n; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// True if all values are reproduced within precision when stored as float.
+bool FitsFloat(std::vector<double> const& values, double precision)
+{
+    for (auto value : values) {
+        auto stored = static_cast<double>(static_cast<float>(value));
+        if (!(std::abs(stored - value) <= precision * std::abs(value)))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+void WriteValues(std::ostream& out, std::vector<double> const& values)
+{
+    auto converted = std::vector<T>(values.begin(), values.end());
+    out.write(reinterpret_cast<const char*>(converted.data()),
+        converted.size() * sizeof(T));
+}
+
+bool AxesMatch(std::array<std::array<double, 2>, 2> const& axes,
+    std::array<std::array<double, 2>, 2> const& expected)
+{
+    for (size_t i = 0; i < 2; ++i)
+        for (size_t j = 0; j < 2; ++j)
+            if (!(std::abs(axes[i][j] - expected[i][j])
+                    <= 1e-12 * std::abs(expected[i][j])))
+                return false;
+    return true;
+}
+
+// Node of the axis at position x, or -1 if x is not a node.
+long NodeIndex(const cubic_splines::Axis<double>& axis, double x)
+{
+    auto t = axis.transform(x);
+    auto i = std::lround(t);
+    if (i < 0 || i >= static_cast<long>(axis.GetNodes())
+        || std::abs(t - i) > 1e-6)
+        return -1;
+    return i;
+}
+
+// Values of a table which is being built, filled while the interpolant
+// evaluates its function at the nodes.
+struct Recording {
+    TableArchive::TableData data;
+    std::vector<char> filled;
+
+    Recording(std::array<size_t, 2> nodes, bool derivatives)
+        : filled(nodes[0] * nodes[1], 0)
+    {
+        data.nodes = nodes;
+        data.values.resize(nodes[0] * nodes[1]);
+        if (derivatives)
+            data.derivatives.resize(nodes[0] * nodes[1]);
+    }
+
+    bool Complete() const
+    {
+        for (auto f : filled)
+            if (!f)
+                return false;
+        return true;
+    }
+};
+
+struct ArchiveState {
+    std::mutex mutex;
+    std::string file;
+    bool opened = false;
+    std::shared_ptr<const TableArchive> archive;
+    std::map<std::string, std::shared_ptr<Recording>> pending;
+};
+
+// name under which a file is written before it is renamed to file
+std::string TemporaryFile(const std::string& file)
+{
+#ifdef _WIN32
+    return file + ".tmp." + std::to_string(_getpid());
+#else
+    return file + ".tmp." + std::to_string(::getpid());
+#endif
+}
+
+ArchiveState& State()
+{
+    static ArchiveState state;
+    return state;
+}
+
+std::shared_ptr<Recording> StartRecording(const std::string& name,
+    std::array<size_t, 2> nodes, std::array<std::array<double, 2>, 2> axes,
+    bool derivatives)
+{
+    auto recording = std::make_shared<Recording>(nodes, derivatives);
+    recording->data.axes = axes;
+    auto& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.pending[name] = recording;
+    return recording;
+}
+} // namespace
+
+TableArchive::TableArchive(const std::string& file)
+{
+    Map(file);
+
+    auto fail = [this, &file](const std::string& reason) {
+        Unmap();
+        throw std::runtime_error(
+            "Invalid table archive '" + file + "': " + reason);
+    };
+
+    if (size_ < sizeof(ArchiveHeader))
+        fail("file too small");
+    ArchiveHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, archive_magic, sizeof(archive_magic)) != 0)
+        fail("wrong file type");
+    if (header.version != archive_version)
+        fail("unsupported version " + std::to_string(header.version));
+    if (header.index_offset > size_)
+        fail("index out of range");
+
+    auto pos = static_cast<size_t>(header.index_offset);
+    for (uint32_t n = 0; n < header.n_tables; ++n) {
+        if (pos + sizeof(IndexEntry) > size_)
+            fail("index truncated");
+        IndexEntry entry;
+        std::memcpy(&entry, data_ + pos, sizeof(entry));
+        pos += sizeof(IndexEntry);
+        if (pos + entry.name_length > size_)
+            fail("index truncated");
+        auto name = std::string(data_ + pos, entry.name_length);
+        pos += Padded(entry.name_length);
+
+        auto table = Table();
+        table.nodes = { { static_cast<size_t>(entry.nodes[0]),
+            static_cast<size_t>(entry.nodes[1]) } };
+        table.axes = { { { { entry.axes[0][0], entry.axes[0][1] } },
+            { { entry.axes[1][0], entry.axes[1][1] } } } };
+        table.single_precision = entry.flags & single_precision;
+        table.checksum = entry.checksum;
+
+        auto n_values = table.nodes[0] * table.nodes[1];
+        auto value_size = table.single_precision ? sizeof(float) : sizeof(double);
+        table.size = n_values * value_size * (entry.flags & has_derivatives ? 2 : 1);
+        if (entry.offset % sizeof(double) != 0 || entry.offset < sizeof(ArchiveHeader)
+            || entry.offset + table.size > header.index_offset)
+            fail("data of table " + name + " out of range");
+
+        table.values = data_ + entry.offset;
+        if (entry.flags & has_derivatives)
+            table.derivatives = table.values + n_values * value_size;
+        tables_[name] = table;
+    }
+}
+
+TableArchive::~TableArchive() { Unmap(); }
+
+void TableArchive::Map(const std::string& file)
+{
+#ifdef _WIN32
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (!in)
+        throw std::runtime_error("Unable to open table archive '" + file + "'.");
+    buffer_.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(buffer_.data(), buffer_.size());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    auto fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open table archive '" + file + "'.");
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Unable to read table archive '" + file + "'.");
+    }
+    auto addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error("Unable to map table archive '" + file + "'.");
+    data_ = static_cast<const char*>(addr);
+    size_ = st.st_size;
+#endif
+}
+
+void TableArchive::Unmap()
+{
+#ifndef _WIN32
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    tables_.clear();
+}
+
+double TableArchive::Table::Value(size_t i) const
+{
+    if (single_precision) {
+        float value;
+        std::memcpy(&value, values + i * sizeof(float), sizeof(float));
+        return value;
+    }
+    double value;
+    std::memcpy(&value, values + i * sizeof(double), sizeof(double));
+    return value;
+}
+
+double TableArchive::Table::Derivative(size_t i) const
+{
+    if (single_precision) {
+        float value;
+        std::memcpy(&value, derivatives + i * sizeof(float), sizeof(float));
+        return value;
+    }
+    double value;
+    std::memcpy(&value, derivatives + i * sizeof(double), sizeof(double));
+    return value;
+}
+
+bool TableArchive::Table::IsIntact() const
+{
+    return Checksum(values, size) == checksum;
+}
+
+const TableArchive::Table* TableArchive::Find(const std::string& name) const
+{
+    auto it = tables_.find(name);
+    if (it == tables_.end())
+        return nullptr;
+    return &it->second;
+}
+
+std::vector<std::string> TableArchive::GetNames() const
+{
+    auto names = std::vector<std::string>();
+    for (auto& table : tables_)
+        names.push_back(table.first);
+    return names;
+}
+
+void TableArchive::Write(
+    const std::string& file, const std::map<std::string, TableData>& tables)
+{
+    auto tmp_file = TemporaryFile(file);
+    {
+        std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error(
+                "Unable to write table archive '" + tmp_file + "'.");
+
+        // the data of every table, padded to a multiple of eight bytes
+        auto blocks = std::vector<std::string>();
+        auto entries = std::vector<IndexEntry>();
+        uint64_t offset = sizeof(ArchiveHeader);
+        auto precision = InterpolationSettings::ARCHIVE_FLOAT_PRECISION;
+        for (auto& table : tables) {
+            auto& data = table.second;
+            if (data.values.size() != data.nodes[0] * data.nodes[1]
+                || (!data.derivatives.empty()
+                    && data.derivatives.size() != data.values.size()))
+                throw std::invalid_argument(
+                    "Node values of table " + table.first + " do not match the number of nodes.");
+
+            auto entry = IndexEntry();
+            entry.name_length = static_cast<uint32_t>(table.first.size());
+            if (!data.derivatives.empty())
+                entry.flags |= has_derivatives;
+            if (precision > 0 && FitsFloat(data.values, precision)
+                && FitsFloat(data.derivatives, precision))
+                entry.flags |= single_precision;
+            entry.nodes[0] = data.nodes[0];
+            entry.nodes[1] = data.nodes[1];
+            for (size_t i = 0; i < 2; ++i)
+                for (size_t j = 0; j < 2; ++j)
+                    entry.axes[i][j] = data.axes[i][j];
+
+            std::ostringstream block;
+            if (entry.flags & single_precision) {
+                WriteValues<float>(block, data.values);
+                WriteValues<float>(block, data.derivatives);
+            } else {
+                WriteValues<double>(block, data.values);
+                WriteValues<double>(block, data.derivatives);
+            }
+            auto bytes = block.str();
+            entry.checksum = Checksum(bytes.data(), bytes.size());
+            entry.offset = offset;
+            bytes.resize(Padded(bytes.size()), '\0');
+            offset += bytes.size();
+            blocks.push_back(std::move(bytes));
+            entries.push_back(entry);
+        }
+
+        auto header = ArchiveHeader();
+        std::memcpy(header.magic, archive_magic, sizeof(archive_magic));
+        header.version = archive_version;
+        header.n_tables = static_cast<uint32_t>(tables.size());
+        header.index_offset = offset;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (auto& bytes : blocks)
+            out.write(bytes.data(), bytes.size());
+
+        const char padding[8] = {};
+        auto entry = entries.begin();
+        for (auto& table : tables) {
+            out.write(reinterpret_cast<const char*>(&*entry++), sizeof(IndexEntry));
+            out.write(table.first.data(), table.first.size());
+            out.write(padding, Padded(table.first.size()) - table.first.size());
+        }
+        if (!out)
+            throw std::runtime_error(
+                "Unable to write table archive '" + tmp_file + "'.");
+    }
+
+#ifdef _WIN32
+    std::remove(file.c_str());
+#endif
+    if (std::rename(tmp_file.c_str(), file.c_str()) != 0) {
+        std::remove(tmp_file.c_str());
+        throw std::runtime_error(
+            "Unable to move table archive to '" + file + "'.");
+    }
+}
+
+bool TableArchive::IsEnabled()
+{
+    return !InterpolationSettings::TABLES_ARCHIVE.empty();
+}
+
+std::string TableArchive::GetTablesPath()
+{
+    if (IsEnabled())
+        return "";
+    return InterpolationSettings::TABLES_PATH;
+}
+
+std::string TableArchive::GetTableFile(const std::string& name)
+{
+    if (IsEnabled())
+        return "";
+    return name;
+}
+
+bool TableArchive::TableFileExists(
+    const std::string& path, const std::string& name)
+{
+    return Helper::file_exists(path + "/" + name);
+}
+
+std::string TableArchive::GetWriteFile(
+    const std::string& path, const std::string& name)
+{
+    if (TableFileExists(path, name))
+        return name;
+    // a temporary file left behind by a crashed process with the same pid
+    // would be read as a finished table, so it is removed first
+    auto file = TemporaryFile(name);
+    std::remove((path + "/" + file).c_str());
+    return file;
+}
+
+void TableArchive::MoveWrittenFile(
+    const std::string& path, const std::string& file, const std::string& name)
+{
+    if (file == name)
+        return;
+    auto tmp_file = path + "/" + file;
+    if (!Helper::file_exists(tmp_file))
+        return; // the interpolant has not been able to write the table
+    if (std::rename(tmp_file.c_str(), (path + "/" + name).c_str()) != 0) {
+        std::remove(tmp_file.c_str());
+        Logging::Get("TableCreation")->warn("Unable to move table to '{}/{}'. "
+                                            "Table will only be stored in memory.", path, name);
+    }
+}
+
+void TableArchive::RemoveWrittenFile(
+    const std::string& path, const std::string& file, const std::string& name)
+{
+    if (file != name)
+        std::remove((path + "/" + file).c_str());
+}
+
+bool TableArchive::IsArchived(const std::string& name)
+{
+    if (!IsEnabled())
+        return false;
+    auto archive = Get();
+    return archive && archive->Find(name);
+}
+
+namespace {
+struct CreationTimes {
+    std::mutex mutex;
+    std::vector<TableArchive::CreationTime> times;
+};
+
+CreationTimes& GetCreationTimes()
+{
+    static CreationTimes times;
+    return times;
+}
+} // namespace
+
+void TableArchive::AddCreationTime(const std::string& name,
+    std::chrono::steady_clock::time_point start, bool created)
+{
+    auto seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    auto& times = GetCreationTimes();
+    std::lock_guard<std::mutex> lock(times.mutex);
+    times.times.push_back({ name, seconds, created });
+}
+
+std::vector<TableArchive::CreationTime> TableArchive::TakeCreationTimes()
+{
+    auto& times = GetCreationTimes();
+    std::lock_guard<std::mutex> lock(times.mutex);
+    auto taken = std::vector<CreationTime>();
+    taken.swap(times.times);
+    return taken;
+}
+
+std::shared_ptr<const TableArchive> TableArchive::Get()
+{
+    auto& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.opened && state.file == InterpolationSettings::TABLES_ARCHIVE)
+        return state.archive;
+
+    state.file = InterpolationSettings::TABLES_ARCHIVE;
+    state.archive = nullptr;
+    state.opened = true;
+    if (!state.file.empty() && Helper::file_exists(state.file)) {
+        try {
+            state.archive = std::make_shared<const TableArchive>(state.file);
+        } catch (const std::runtime_error& e) {
+            Logging::Get("TableCreation")->warn("{} The tables will be created again.", e.what());
+        }
+    }
+    return state.archive;
+}
+
+namespace {
+// Table stored under name if it is intact and matches the definition,
+// otherwise nullptr.
+const TableArchive::Table* FindMatching(const TableArchive* archive,
+    const std::string& name, std::array<size_t, 2> nodes,
+    std::array<std::array<double, 2>, 2> const& axes, bool derivatives)
+{
+    auto table = archive ? archive->Find(name) : nullptr;
+    if (!table)
+        return nullptr;
+    if (table->nodes != nodes || !AxesMatch(table->axes, axes)
+        || (derivatives && !table->derivatives)) {
+        Logging::Get("TableCreation")->warn("Table {} in the archive does not match its definition "
+                                            "and is created again.", name);
+        return nullptr;
+    }
+    if (!table->IsIntact()) {
+        Logging::Get("TableCreation")->warn("Table {} in the archive is corrupted and is created again.",
+            name);
+        return nullptr;
+    }
+    return table;
+}
+} // namespace
+
+cubic_splines::CubicSplines<double>::Definition TableArchive::Use(
+    cubic_splines::CubicSplines<double>::Definition def, const std::string& name)
+{
+    if (!IsEnabled())
+        return def;
+
+    // the axis is owned by the definition, which is kept by the interpolant
+    // while it evaluates the functions
+    const auto* axis = def.axis.get();
+    auto n = axis->GetNodes();
+    auto axes = std::array<std::array<double, 2>, 2> { { { { axis->GetLow(),
+        axis->GetHigh() } } } };
+    auto archive = Get();
+    auto table = FindMatching(archive.get(), name, { { n, 1 } }, axes, bool(def.df));
+    if (table) {
+        auto f = def.f;
+        def.f = [archive, table, axis, f](double x) {
+            auto i = NodeIndex(*axis, x);
+            return i < 0 ? f(x) : table->Value(i);
+        };
+        if (def.df) {
+            auto df = def.df;
+            def.df = [archive, table, axis, df](double x) {
+                auto i = NodeIndex(*axis, x);
+                return i < 0 ? df(x) : table->Derivative(i);
+            };
+        }
+        return def;
+    }
+
+    auto recording = StartRecording(name, { { n, 1 } }, axes, bool(def.df));
+    auto f = def.f;
+    def.f = [recording, axis, f](double x) {
+        auto value = f(x);
+        auto i = NodeIndex(*axis, x);
+        if (i >= 0) {
+            recording->data.values[i] = value;
+            recording->filled[i] = 1;
+        }
+        return value;
+    };
+    if (def.df) {
+        auto df = def.df;
+        def.df = [recording, axis, df](double x) {
+            auto value = df(x);
+            auto i = NodeIndex(*axis, x);
+            if (i >= 0)
+                recording->data.derivatives[i] = value;
+            return value;
+        };
+    }
+    return def;
+}
+
+cubic_splines::BicubicSplines<double>::Definition TableArchive::Use(
+    cubic_splines::BicubicSplines<double>::Definition def, const std::string& name)
+{
+    if (!IsEnabled())
+        return def;
+
+    const auto* axis_0 = def.axis[0].get();
+    const auto* axis_1 = def.axis[1].get();
+    auto nodes = std::array<size_t, 2> { { axis_0->GetNodes(), axis_1->GetNodes() } };
+    auto axes = std::array<std::array<double, 2>, 2> { { { { axis_0->GetLow(),
+        axis_0->GetHigh() } }, { { axis_1->GetLow(), axis_1->GetHigh() } } } };
+    auto archive = Get();
+    auto table = FindMatching(archive.get(), name, nodes, axes, false);
+    if (table) {
+        auto f = def.f;
+        def.f = [archive, table, axis_0, axis_1, f](double x_0, double x_1) {
+            auto i = NodeIndex(*axis_0, x_0);
+            auto j = NodeIndex(*axis_1, x_1);
+            if (i < 0 || j < 0)
+                return f(x_0, x_1);
+            return table->Value(i * table->nodes[1] + j);
+        };
+        return def;
+    }
+
+    auto recording = StartRecording(name, nodes, axes, false);
+    auto f = def.f;
+    def.f = [recording, axis_0, axis_1, f](double x_0, double x_1) {
+        auto value = f(x_0, x_1);
+        auto i = NodeIndex(*axis_0, x_0);
+        auto j = NodeIndex(*axis_1, x_1);
+        if (i >= 0 && j >= 0) {
+            auto idx = i * recording->data.nodes[1] + j;
+            recording->data.values[idx] = value;
+            recording->filled[idx] = 1;
+        }
+        return value;
+    };
+    return def;
+}
+
+void TableArchive::WritePending()
+{
+    auto archive = Get();
+
+    auto& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.pending.empty())
+        return;
+
+    auto tables = std::map<std::string, TableData>();
+    for (auto& recording : state.pending) {
+        if (recording.second->Complete())
+            tables[recording.first] = recording.second->data;
+        else
+            Logging::Get("TableCreation")->warn("Table {} has not been evaluated at all nodes and is not archived.",
+                recording.first);
+    }
+    state.pending.clear();
+    if (tables.empty())
+        return;
+
+    // other processes may have extended the archive since it has been
+    // mapped, so it is read again while they are locked out
+    TableLock file_lock(state.file);
+    if (Helper::file_exists(state.file)) {
+        try {
+            archive = std::make_shared<const TableArchive>(state.file);
+        } catch (const std::runtime_error& e) {
+            Logging::Get("TableCreation")->warn("{} The tables will be replaced.", e.what());
+        }
+    }
+
+    if (archive) {
+        for (auto& name : archive->GetNames()) {
+            if (tables.count(name))
+                continue;
+            auto table = archive->Find(name);
+            auto n_values = table->nodes[0] * table->nodes[1];
+            auto& data = tables[name];
+            data.nodes = table->nodes;
+            data.axes = table->axes;
+            for (size_t i = 0; i < n_values; ++i)
+                data.values.push_back(table->Value(i));
+            if (table->derivatives)
+                for (size_t i = 0; i < n_values; ++i)
+                    data.derivatives.push_back(table->Derivative(i));
+        }
+    }
+
+    try {
+        Write(state.file, tables);
+        Logging::Get("TableCreation")->info("Wrote {} tables to archive '{}'.", tables.size(), state.file);
+    } catch (const std::exception& e) {
+        Logging::Get("TableCreation")->warn("{} Tables will only be stored in memory.", e.what());
+    }
+    // map the new archive on the next access
+    state.opened = false;
+}
@@ -0,0 +1,69 @@
+#include "PROPOSAL/math/TableLock.h"
+#include "PROPOSAL/Logging.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace PROPOSAL;
+
+#ifndef _WIN32
+namespace {
+bool lock_fd(int fd, bool wait)
+{
+    struct flock lock = {};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    while (::fcntl(fd, wait ? F_SETLKW : F_SETLK, &lock) != 0) {
+        if (errno != EINTR)
+            return false;
+    }
+    return true;
+}
+} // namespace
+#endif
+
+TableLock::TableLock(const std::string& file)
+    : lock_file_(file + ".lock")
+{
+#ifndef _WIN32
+    while (true) {
+        fd_ = ::open(lock_file_.c_str(), O_RDWR | O_CREAT, 0666);
+        if (fd_ < 0) {
+            Logging::Get("TableCreation")->debug("Unable to create lock file '{}'. "
+                                                 "Table is created without lock.", lock_file_);
+            return;
+        }
+        if (!lock_fd(fd_, false)) {
+            Logging::Get("TableCreation")->info("Waiting for table '{}' to be created by another process.", file);
+            if (!lock_fd(fd_, true)) {
+                Logging::Get("TableCreation")->debug("Unable to lock '{}'. "
+                                                     "Table is created without lock.", lock_file_);
+                ::close(fd_);
+                fd_ = -1;
+                return;
+            }
+        }
+        // the previous owner removes the lock file before releasing it, so
+        // the lock is only valid if it belongs to the current lock file
+        struct stat locked, current;
+        if (::fstat(fd_, &locked) == 0 && ::stat(lock_file_.c_str(), &current) == 0
+            && locked.st_dev == current.st_dev && locked.st_ino == current.st_ino)
+            return;
+        ::close(fd_);
+    }
+#endif
+}
+
+TableLock::~TableLock()
+{
+#ifndef _WIN32
+    if (fd_ >= 0) {
+        ::unlink(lock_file_.c_str());
+        ::close(fd_);
+    }
+#endif
+}
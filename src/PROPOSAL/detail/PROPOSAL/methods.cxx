@@ -10,15 +10,43 @@
 // #include <stdlib.h>
 
 #include "PROPOSAL/methods.h"
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/Logging.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <string>
+#include <thread>
 
 namespace PROPOSAL {
 
 std::string LogTableCreation::warn_for_path = "";
+std::mutex LogTableCreation::mutex;
 
 LogTableCreation::LogTableCreation(const std::string &path, const std::string &filename) {
+    // Contains() waits for a table of the same name which is being built, so
+    // it is called before locking out the logging of other tables
+    if (InterpolantRegistry::Contains(filename)) {
+        Logging::Get("TableCreation")->debug("Table {} is already in use and is shared.", filename);
+        return;
+    }
+    // tables may be built concurrently
+    std::lock_guard<std::mutex> lock(mutex);
+    if (TableArchive::IsEnabled()) {
+        auto archive = TableArchive::Get();
+        if (archive && archive->Find(filename)) {
+            Logging::Get("TableCreation")->debug("Table {} is available and is read from archive '{}'.",
+                                                 filename, InterpolationSettings::TABLES_ARCHIVE);
+        } else if (warn_for_path != InterpolationSettings::TABLES_ARCHIVE) {
+            Logging::Get("TableCreation")->warn("Tables are not available and need to be created. "
+                                                "They will be added to the archive '{}'. "
+                                                "This can take some minutes.", InterpolationSettings::TABLES_ARCHIVE);
+            warn_for_path = InterpolationSettings::TABLES_ARCHIVE;
+        }
+        return;
+    }
     // TODO: use std::filesystem when we switch to c++17
     auto combined = path + "/" + filename;
     if (!Helper::file_exists(combined)) {
@@ -63,6 +91,57 @@ namespace Helper {
         return lhs < rhs;
     }
 
+    // threads started by ParallelFor which are currently running
+    static std::atomic<unsigned int> parallel_threads { 0 };
+
+    void ParallelFor(size_t n, std::function<void(size_t)> const& f)
+    {
+        auto max_threads = InterpolationSettings::TABLE_BUILD_THREADS;
+        if (max_threads == 0)
+            max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        // reserve additional threads, the calling thread always takes part
+        unsigned int n_threads = 0;
+        auto wanted = static_cast<unsigned int>(
+            std::min<size_t>(n, max_threads) - (n > 0 ? 1 : 0));
+        auto running = parallel_threads.load();
+        while (wanted > 0 && running + 1 < max_threads) {
+            auto n_free = std::min(wanted, max_threads - 1 - running);
+            if (parallel_threads.compare_exchange_weak(
+                    running, running + n_free)) {
+                n_threads = n_free;
+                break;
+            }
+        }
+
+        std::atomic<size_t> next { 0 };
+        std::exception_ptr error = nullptr;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            for (auto i = next++; i < n; i = next++) {
+                try {
+                    f(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_threads);
+        for (unsigned int i = 0; i < n_threads; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+        parallel_threads -= n_threads;
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
 } // namespace Helper
 
 } // namespace PROPOSAL
@@ -71,15 +71,17 @@ std::ostream& operator<<(std::ostream& os, ParticleDef const& def)
     return os;
 }
 
-ParticleDef ParticleDef::GetParticleDefForType(int type) {
-    if (!Type_Particle_Map) {
-        Type_Particle_Map = std::make_unique<std::unordered_map<int, ParticleDef>>();
-        for (const auto& p: create_particle_map())
-            Type_Particle_Map->insert(p);
-    }
+const std::unordered_map<int, ParticleDef>& ParticleDef::GetTypeParticleMap() {
+    if (!Type_Particle_Map)
+        Type_Particle_Map = std::make_unique<std::unordered_map<int, ParticleDef>>(
+            create_particle_map());
+    return *Type_Particle_Map;
+}
 
-    auto p_search = Type_Particle_Map->find(type);
-    if (p_search != Type_Particle_Map->end()) {
+ParticleDef ParticleDef::GetParticleDefForType(int type) {
+    auto const& particle_map = GetTypeParticleMap();
+    auto p_search = particle_map.find(type);
+    if (p_search != particle_map.end()) {
         return p_search->second;
     }
     throw std::invalid_argument("ParticleState: ParticleDef not found for "
@@ -87,6 +89,15 @@ ParticleDef ParticleDef::GetParticleDefForType(int type) {
 
 }
 
+ParticleDef ParticleDef::GetParticleDefForName(const std::string& name) {
+    for (const auto& p: GetTypeParticleMap()) {
+        if (p.second.name == name)
+            return p.second;
+    }
+    throw std::invalid_argument("ParticleDef: ParticleDef not found for "
+                                "given name " + name);
+}
+
 
 } // namespace PROPOSAL
 
@@ -1,7 +1,10 @@
 #include "PROPOSAL/propagation_utility/Interaction.h"
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/crosssection/CrossSection.h"
 #include "PROPOSAL/propagation_utility/Displacement.h"
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <numeric>
 
@@ -15,6 +18,89 @@ Interaction::Interaction(
 {
     if (cross_list.size() < 1)
         throw std::invalid_argument("At least one crosssection is required.");
+    for (auto& c : cross_list)
+        for (size_t i = 0; i < c->GetNumComponents(); ++i)
+            channels.push_back({ c.get(), i });
+    auto lower = INF;
+    for (auto& c : cross_list)
+        lower = std::min(lower, c->GetLowerEnergyLim());
+    auto upper = InterpolationSettings::UPPER_ENERGY_LIM;
+    if (InterpolationSettings::NODES_CHANNEL_TABLE > 0 && !channels.empty()
+        && lower > 0 && lower < upper)
+        channel_table = std::make_unique<SegmentedTable<ChannelTable>>(lower,
+            upper, InterpolationSettings::NODES_CHANNEL_TABLE, hash,
+            [this](EnergySegmentation::Segment const& segment) {
+                return BuildChannelTable(segment);
+            });
+}
+
+Interaction::ChannelTable Interaction::BuildChannelTable(
+    EnergySegmentation::Segment const& segment) const
+{
+    // with a tolerance, the segment starts from a coarse number of nodes
+    // meant to be refined, so the channels use the maximum
+    auto table = ChannelTable();
+    table.nodes = std::max(segment.max_nodes, 2u);
+    table.log_lower = std::log(segment.low);
+    table.log_step
+        = (std::log(segment.up) - table.log_lower) / (table.nodes - 1);
+    table.fractions.resize(table.nodes * channels.size());
+    table.has_rate.resize(table.nodes);
+    for (size_t i = 0; i < table.nodes; ++i) {
+        auto energy = std::exp(table.log_lower + i * table.log_step);
+        auto fractions = table.fractions.begin() + i * channels.size();
+        auto cumulated_rate = 0.;
+        for (size_t k = 0; k < channels.size(); ++k) {
+            cumulated_rate += channels[k].crosssection->CalculatedNdx_ByIndex(
+                energy, channels[k].comp_index);
+            fractions[k] = cumulated_rate;
+        }
+        table.has_rate[i] = cumulated_rate > 0;
+        if (table.has_rate[i])
+            for (size_t k = 0; k < channels.size(); ++k)
+                fractions[k] /= cumulated_rate;
+    }
+    return table;
+}
+
+bool Interaction::SampleLossFromTable(
+    double energy, double rnd, Loss& loss) const
+{
+    if (!(energy >= channel_table->GetLow()) || energy > channel_table->GetUp())
+        return false;
+    auto& table = channel_table->At(energy);
+    auto x = (std::log(energy) - table.log_lower) / table.log_step;
+    if (!(x >= 0) || x > table.nodes - 1)
+        return false;
+    auto i = std::min(static_cast<size_t>(x), table.nodes - 2);
+    if (!table.has_rate[i] || !table.has_rate[i + 1])
+        return false;
+    auto t = x - i;
+    auto lower = table.fractions.data() + i * channels.size();
+    auto upper = lower + channels.size();
+
+    auto previous_fraction = 0.;
+    for (size_t k = 0; k < channels.size(); ++k) {
+        auto fraction = lower[k] + t * (upper[k] - lower[k]);
+        if (rnd < fraction) {
+            auto& channel = channels[k];
+            auto rate = channel.crosssection->CalculatedNdx_ByIndex(
+                energy, channel.comp_index);
+            if (!(rate > 0))
+                return false;
+            // position of rnd within the fraction of the channel, as the
+            // rate left to sample the energy loss from
+            auto sampled_rate
+                = rate * (fraction - rnd) / (fraction - previous_fraction);
+            loss = { channel.crosssection->GetInteractionType(),
+                channel.crosssection->GetComponentHash(channel.comp_index),
+                channel.crosssection->CalculateStochasticLoss_ByIndex(
+                    channel.comp_index, energy, sampled_rate) };
+            return true;
+        }
+        previous_fraction = fraction;
+    }
+    return false;
 }
 
 double Interaction::FunctionToIntegral(double energy) const
@@ -33,7 +119,7 @@ double Interaction::calculate_total_rate(double energy) const {
 }
 
 Interaction::Loss Interaction::SampleLoss(
-    double energy, std::vector<Rate> const& rates, double rnd)
+    double energy, std::vector<Rate> const& rates, double rnd) const
 {
     auto overall_rate = std::accumulate(rates.begin(), rates.end(), 0.,
         [](double a, Rate r) { return a + r.rate; });
@@ -41,12 +127,50 @@ Interaction::Loss Interaction::SampleLoss(
     for (auto& r : rates) {
         sampled_rate -= r.rate;
         if (sampled_rate < 0.) {
-            auto loss = r.crosssection->CalculateStochasticLoss(
-                r.comp_hash, energy, -sampled_rate);
-            return { r.crosssection->GetInteractionType(), r.comp_hash, loss };
+            auto loss = r.crosssection->CalculateStochasticLoss_ByIndex(
+                r.comp_index, energy, -sampled_rate);
+            return { r.crosssection->GetInteractionType(),
+                r.crosssection->GetComponentHash(r.comp_index), loss };
         }
     }
 
+    return LossNotSampled(energy, overall_rate, sampled_rate, rnd);
+}
+
+Interaction::Loss Interaction::SampleLoss(double energy, double rnd) const
+{
+    auto loss = Loss();
+    if (channel_table && SampleLossFromTable(energy, rnd, loss))
+        return loss;
+
+    // the interaction is shared by all propagating threads, so the rates are
+    // kept per thread
+    thread_local std::vector<double> rates;
+    rates.resize(channels.size());
+    auto overall_rate = 0.;
+    for (size_t k = 0; k < channels.size(); ++k) {
+        rates[k] = channels[k].crosssection->CalculatedNdx_ByIndex(
+            energy, channels[k].comp_index);
+        overall_rate += rates[k];
+    }
+    auto sampled_rate = rnd * overall_rate;
+    for (size_t k = 0; k < channels.size(); ++k) {
+        auto& channel = channels[k];
+        sampled_rate -= rates[k];
+        if (sampled_rate < 0.) {
+            auto loss = channel.crosssection->CalculateStochasticLoss_ByIndex(
+                channel.comp_index, energy, -sampled_rate);
+            return { channel.crosssection->GetInteractionType(),
+                channel.crosssection->GetComponentHash(channel.comp_index),
+                loss };
+        }
+    }
+    return LossNotSampled(energy, overall_rate, sampled_rate, rnd);
+}
+
+Interaction::Loss Interaction::LossNotSampled(double energy,
+    double overall_rate, double sampled_rate, double rnd) const
+{
     if (overall_rate == 0.) {
         Logging::Get("proposal.interaction")->warn(
                 "No stochastic interaction possible for initial energy {} MeV.",
@@ -64,14 +188,14 @@ Interaction::Loss Interaction::SampleLoss(
     throw std::logic_error(ss.str());
 }
 
-std::vector<Interaction::Rate> Interaction::Rates(double energy)
+std::vector<Interaction::Rate> Interaction::Rates(double energy) const
 {
     auto rates = std::vector<Rate>();
+    rates.reserve(channels.size());
     for (auto& c : cross_list) {
-        auto dndx_per_target = c->CalculatedNdx_PerTarget(energy);
-        for (auto dndx : dndx_per_target)
+        for (size_t i = 0; i < c->GetNumComponents(); ++i)
             rates.emplace_back(
-                Interaction::Rate { c, dndx.first, dndx.second });
+                Interaction::Rate { c, i, c->CalculatedNdx_ByIndex(energy, i) });
     }
     return rates;
 }
@@ -4,6 +4,9 @@
 #include "PROPOSAL/crosssection/CrossSectionDNDX/AxisBuilderDNDX.h"
 #include "PROPOSAL/crosssection/CrossSection.h"
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/TableArchive.h"
 
 using namespace PROPOSAL;
 
@@ -38,29 +41,44 @@ InteractionBuilder::InteractionBuilder(std::shared_ptr<Displacement> _disp,
         rate_interpolant_ = nullptr;
 }
 
-InteractionBuilder::interpolant_ptr InteractionBuilder::InitializeRateInterpolant() {
+std::unique_ptr<InteractionBuilder::table_t>
+InteractionBuilder::InitializeRateInterpolant() {
     auto energy_lim = AxisBuilderDNDX::energy_limits();
     energy_lim.low = disp->GetLowerLim();
     energy_lim.up = InterpolationSettings::UPPER_ENERGY_LIM;
     energy_lim.nodes = InterpolationSettings::NODES_RATE_INTERPOLANT;
     auto energy_lim_refined = AxisBuilderDNDX::refine_definition_range(
             energy_lim, [&](double E) { return calculate_total_rate(E); });
-    auto def = cubic_splines::CubicSplines<double>::Definition();
-    def.f = [&](double energy) {
-        return calculate_total_rate(energy);
-    };
-    auto axis = AxisBuilderDNDX::Create(energy_lim_refined);
-    def.axis = std::move(axis);
-    rate_lower_energy_lim = def.axis->GetLow();
 
     auto rate_interpolant_hash = this->GetHash();
     hash_combine(rate_interpolant_hash,
                  InterpolationSettings::NODES_RATE_INTERPOLANT,
                  InterpolationSettings::UPPER_ENERGY_LIM);
 
-    return std::make_shared<interpolant_t>(
-            std::move(def), std::string(InterpolationSettings::TABLES_PATH),
-            std::string("rates_") + std::to_string(rate_interpolant_hash) + std::string(".dat"));
+    auto table = std::make_unique<table_t>(energy_lim_refined.low,
+        energy_lim_refined.up, energy_lim_refined.nodes, rate_interpolant_hash,
+        [this](table_t::Segment segment) {
+            auto gen_name = [](size_t hash) {
+                return std::string("rates_") + std::to_string(hash)
+                    + std::string(".dat");
+            };
+            auto create = [f = NodeRefinement::StoreValues([this](double energy) {
+                return calculate_total_rate(energy);
+            })](table_t::Segment const& segment) {
+                auto def = cubic_splines::CubicSplines<double>::Definition();
+                def.f = f;
+                def.axis = AxisBuilderDNDX::Create(
+                    { segment.low, segment.up, segment.nodes });
+                return def;
+            };
+            segment = NodeRefinement::Refine(segment, create, gen_name);
+            auto name = gen_name(segment.hash);
+            return InterpolantRegistry::Get<interpolant_t>(name, [&]() {
+                return TableArchive::Create<interpolant_t>(create(segment), name);
+            });
+        });
+    rate_lower_energy_lim = table->GetLow();
+    return table;
 }
 
 double InteractionBuilder::EnergyInteraction(double energy, double rnd)
@@ -81,7 +99,7 @@ double InteractionBuilder::MeanFreePath(double energy) {
     if (rate_interpolant_) {
         if (energy < rate_lower_energy_lim)
             return INF;
-        auto rate = rate_interpolant_->evaluate(energy);
+        auto rate = rate_interpolant_->At(energy)->evaluate(energy);
         if (rate < 0) {
             Logging::Get("proposal.interaction")->warn(
                     "Negative MeanFreePath detected at energy {} MeV. Returning INF instead.", energy);
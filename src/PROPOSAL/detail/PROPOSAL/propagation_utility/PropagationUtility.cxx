@@ -90,16 +90,13 @@ PropagationUtility::PropagationUtility(
 }
 
 Interaction::Loss PropagationUtility::EnergyStochasticloss(double energy,
-                                                           double rnd)
+                                                           double rnd) const
 {
-    auto rates = collection.interaction_calc->Rates(energy);
-    auto loss = collection.interaction_calc->SampleLoss(energy, rates, rnd);
-
-    return loss;
+    return collection.interaction_calc->SampleLoss(energy, rnd);
 }
 
 double PropagationUtility::EnergyDecay(
-    double energy, std::function<double()> rnd, double density)
+    double energy, std::function<double()> rnd, double density) const
 {
     if (collection.decay_calc) {
         return collection.decay_calc->EnergyDecay(energy, rnd(), density);
@@ -108,14 +105,14 @@ double PropagationUtility::EnergyDecay(
 }
 
 double PropagationUtility::EnergyInteraction(
-    double energy, std::function<double()> rnd)
+    double energy, std::function<double()> rnd) const
 {
     return collection.interaction_calc->EnergyInteraction(energy, rnd());
 }
 
 double PropagationUtility::EnergyRandomize(
     double initial_energy, double final_energy, std::function<double()> rnd,
-    double min_energy = 0)
+    double min_energy = 0) const
 {
     if (collection.cont_rand) {
         final_energy = collection.cont_rand->EnergyRandomize(
@@ -125,14 +122,15 @@ double PropagationUtility::EnergyRandomize(
 }
 
 double PropagationUtility::EnergyDistance(
-    double initial_energy, double distance)
+    double initial_energy, double distance) const
 {
     return collection.displacement_calc->UpperLimitTrackIntegral(
         initial_energy, distance);
 }
 
 double PropagationUtility::TimeElapsed(
-    double initial_energy, double final_energy, double distance, double density)
+    double initial_energy, double final_energy, double distance,
+    double density) const
 {
     return collection.time_calc->TimeElapsed(
         initial_energy, final_energy, distance, density);
@@ -140,7 +138,7 @@ double PropagationUtility::TimeElapsed(
 
 std::tuple<Cartesian3D, Cartesian3D> PropagationUtility::DirectionsScatter(
     double displacement, double initial_energy, double final_energy,
-    const Vector3D& direction, std::function<double()> rnd)
+    const Vector3D& direction, std::function<double()> rnd) const
 {
     if (collection.scattering) {
         std::array<double, 4> random_numbers;
@@ -176,7 +174,7 @@ Cartesian3D PropagationUtility::DirectionDeflect(InteractionType type,
 }
 
 double PropagationUtility::LengthContinuous(
-    double initial_energy, double final_energy)
+    double initial_energy, double final_energy) const
 {
     return collection.displacement_calc->SolveTrackIntegral(
         initial_energy, final_energy);
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <functional>
@@ -6,21 +7,20 @@
 #include "CubicInterpolation/Interpolant.h"
 #include "CubicInterpolation/FindParameter.hpp"
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/PropagationStatistics.h"
 #include "PROPOSAL/propagation_utility/PropagationUtilityInterpolant.h"
 #include "PROPOSAL/methods.h"
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/math/MathMethods.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/TableArchive.h"
 
 using namespace PROPOSAL;
 
-std::string UtilityInterpolant::gen_path() const
+std::string UtilityInterpolant::gen_name(std::string prefix, size_t hash) const
 {
-    return std::string(InterpolationSettings::TABLES_PATH);
-}
-
-std::string UtilityInterpolant::gen_name(std::string prefix) const
-{
-    return std::string(prefix) + std::to_string(this->GetHash())
+    return std::string(prefix) + std::to_string(hash)
         + std::string(".dat");
 }
 UtilityInterpolant::UtilityInterpolant(
@@ -33,33 +33,103 @@ UtilityInterpolant::UtilityInterpolant(
 
 void UtilityInterpolant::BuildTables(const std::string prefix, size_t nodes,
                                      bool reverse) {
-    auto def = cubic_splines::CubicSplines<double>::Definition();
-    auto reference_x = lower_lim;
     reverse_ = reverse;
-    if (reverse_) {
-        reference_x = InterpolationSettings::UPPER_ENERGY_LIM;
-    }
 
     hash_combine(this->hash, nodes, reverse,
                  InterpolationSettings::UPPER_ENERGY_LIM);
 
-    if (reverse) {
-        def.f = [&](double energy) {
-            return UtilityIntegral::Calculate(reference_x, energy);
-        };
-    } else {
-        def.f = [&](double energy) {
-            return UtilityIntegral::Calculate(energy, reference_x);
-        };
-    }
-    def.f_trafo = std::make_unique<cubic_splines::ExpM1Axis<double>>(1., 0.);
-    def.axis = std::make_unique<cubic_splines::ExpAxis<double>>(
-            lower_lim, InterpolationSettings::UPPER_ENERGY_LIM, nodes);
-
-    interpolant_ = std::make_shared<interpolant_t>(
-            std::move(def), gen_path(), gen_name(prefix));
+    // The table of a segment holds the integral from its lower edge, or to
+    // its upper edge if it is reversed. For a table consisting of a single
+    // segment, these are the lower limit and UPPER_ENERGY_LIM.
+    interpolant_ = std::make_unique<table_t>(lower_lim,
+        InterpolationSettings::UPPER_ENERGY_LIM, nodes, this->hash,
+        [this, prefix, reverse](table_t::Segment segment) {
+            auto f = std::function<double(double)>();
+            if (reverse) {
+                f = [this, up = segment.up](double energy) {
+                    return UtilityIntegral::Calculate(up, energy);
+                };
+            } else {
+                f = [this, low = segment.low](double energy) {
+                    return UtilityIntegral::Calculate(energy, low);
+                };
+            }
+            auto create = [f = NodeRefinement::StoreValues(f)](
+                              table_t::Segment const& segment) {
+                auto def = cubic_splines::CubicSplines<double>::Definition();
+                def.f = f;
+                def.f_trafo
+                    = std::make_unique<cubic_splines::ExpM1Axis<double>>(1., 0.);
+                def.axis = std::make_unique<cubic_splines::ExpAxis<double>>(
+                    segment.low, segment.up, segment.nodes);
+                return def;
+            };
+            segment = NodeRefinement::Refine(segment, create,
+                [this, &prefix](size_t hash) { return gen_name(prefix, hash); });
+            auto name = gen_name(prefix, segment.hash);
+            auto tables = Tables();
+            tables.integral = InterpolantRegistry::Get<interpolant_t>(name, [&]() {
+                return TableArchive::Create<interpolant_t>(create(segment), name);
+            });
+            if (!InterpolationSettings::UTILITY_INVERSE_TABLES)
+                return tables;
+
+            // the inverse starts from the lower edge in both directions, since
+            // the distance to the other edge is not resolved at low energies
+            auto start = std::log(segment.low);
+            auto end = std::log(segment.up);
+            auto adjacent = start + (end - start) / (segment.nodes - 1);
+            auto distance = [integral = tables.integral](double log_energy,
+                                double reference) {
+                return std::abs(
+                    integral->evaluate(std::exp(log_energy)) - reference);
+            };
+            tables.reference = tables.integral->evaluate(std::exp(start));
+            tables.scale = distance(adjacent, tables.reference);
+            if (!(tables.scale > 0))
+                return tables;
+            tables.max_scaled = std::log1p(
+                distance(end, tables.reference) / tables.scale);
+
+            // the integrals are monotonic, so log(E) is found by bisection
+            // for each node of the inverse
+            auto inverse_name = gen_name(prefix + "inverse_", segment.hash);
+            tables.inverse = InterpolantRegistry::Get<interpolant_t>(
+                inverse_name, [&]() {
+                    auto def = cubic_splines::CubicSplines<double>::Definition();
+                    def.f = [distance, start, end, reference = tables.reference,
+                                scale = tables.scale](double scaled) {
+                        if (scaled <= 0)
+                            return start;
+                        auto target = scale * std::expm1(scaled);
+                        auto f = [&](double log_energy) {
+                            return distance(log_energy, reference) - target;
+                        };
+                        if (f(end) <= 0)
+                            return end;
+                        auto interval = Bisection(f, start, end, 1e-12, 100);
+                        return (interval.first + interval.second) / 2;
+                    };
+                    def.axis = std::make_unique<cubic_splines::LinAxis<double>>(
+                        0., tables.max_scaled, segment.nodes);
+                    return TableArchive::Create<interpolant_t>(
+                        std::move(def), inverse_name);
+                });
+            return tables;
+        });
 }
 
+double UtilityInterpolant::CalculateInSegment(
+    size_t i, double energy_initial, double energy_final) const
+{
+    auto& interpolant = *interpolant_->Get(i).integral;
+    auto integral_upper_limit = interpolant.evaluate(energy_initial);
+    auto integral_lower_limit = interpolant.evaluate(energy_final);
+
+    if (reverse_)
+        return integral_lower_limit - integral_upper_limit;
+    return integral_upper_limit - integral_lower_limit;
+}
 
 double UtilityInterpolant::Calculate(double energy_initial, double energy_final)
 {
@@ -70,12 +140,21 @@ double UtilityInterpolant::Calculate(double energy_initial, double energy_final)
         return FunctionToIntegral((energy_initial + energy_initial) / 2)
             * (energy_final - energy_initial);
 
-    auto integral_upper_limit = interpolant_->evaluate(energy_initial);
-    auto integral_lower_limit = interpolant_->evaluate(energy_final);
-
-    if (reverse_)
-        return integral_lower_limit - integral_upper_limit;
-    return integral_upper_limit - integral_lower_limit;
+    auto i_initial = interpolant_->Find(energy_initial);
+    auto i_final = interpolant_->Find(energy_final);
+    if (i_initial == i_final)
+        return CalculateInSegment(i_initial, energy_initial, energy_final);
+
+    // sum up the parts of the integral in the segments in between
+    auto integral = CalculateInSegment(i_initial, energy_initial,
+        interpolant_->GetSegment(i_initial).low);
+    for (auto i = i_initial - 1; i > i_final; --i) {
+        auto& segment = interpolant_->GetSegment(i);
+        integral += CalculateInSegment(i, segment.up, segment.low);
+    }
+    integral += CalculateInSegment(i_final,
+        interpolant_->GetSegment(i_final).up, energy_final);
+    return integral;
 }
 
 // ------------------------------------------------------------------------- //
@@ -92,36 +171,75 @@ double UtilityInterpolant::GetUpperLimit(double upper_limit, double rnd)
     if (rnd == max_rnd)
         return lower_lim;
 
+    // go down segment-wise until the segment containing the searched energy
+    auto i = interpolant_->Find(upper_limit);
+    while (i > 0) {
+        auto lower_edge = interpolant_->GetSegment(i).low;
+        auto integral = CalculateInSegment(i, upper_limit, lower_edge);
+        if (rnd <= integral)
+            break;
+        rnd -= integral;
+        upper_limit = lower_edge;
+        --i;
+    }
+    auto lower = std::max(lower_lim, interpolant_->GetSegment(i).low);
+
     if (reverse_)
         rnd = -rnd;
 
-    auto integrated_to_upper = interpolant_->evaluate(upper_limit);
+    auto& tables = interpolant_->Get(i);
+    auto value = tables.integral->evaluate(upper_limit) - rnd;
+    if (tables.inverse) {
+        // the inverse is only accurate relative to the energy, so it is used
+        // as the initial guess of the newton raphson method, which resolves
+        // losses far below this accuracy within one or two steps
+        auto scaled = std::log1p(
+            std::abs(value - tables.reference) / tables.scale);
+        auto energy = std::exp(tables.inverse->evaluate(
+            std::min(scaled, tables.max_scaled)));
+        auto initial_guess = cubic_splines::ParameterGuess<double>();
+        initial_guess.x = std::min(std::max(energy, lower), upper_limit);
+        initial_guess.lower = lower;
+        initial_guess.upper = upper_limit;
+        try {
+            return cubic_splines::find_parameter(
+                *tables.integral, value, initial_guess);
+        } catch (std::runtime_error&) {
+            // solved by bisection and newton raphson below
+        }
+    }
+    return FindEnergy(*tables.integral, value, lower, upper_limit);
+}
+
+double UtilityInterpolant::FindEnergy(interpolant_t const& interpolant,
+    double value, double lower, double upper) const
+{
     auto initial_guess = cubic_splines::ParameterGuess<double>();
 
     // find initial parameters for newton raphson method by using bisection
-    auto f = [this, &integrated_to_upper, &rnd](double val) {
-        return interpolant_->evaluate(val) - (integrated_to_upper - rnd);
+    auto f = [&interpolant, &value](double val) {
+        return interpolant.evaluate(val) - value;
     };
-    auto bisec_tolerance = (upper_limit - lower_lim) * 1e-2;
+    auto bisec_tolerance = (upper - lower) * 1e-2;
     std::tie(initial_guess.lower, initial_guess.upper) =
-            Bisection(f, lower_lim, upper_limit, bisec_tolerance, 100);
+            Bisection(f, lower, upper, bisec_tolerance, 100);
 
     // if we are close to the upper limit, start newton raphson method there
-    if (initial_guess.upper == upper_limit) {
-        initial_guess.x = upper_limit;
+    if (initial_guess.upper == upper) {
+        initial_guess.x = upper;
     }
     else
         initial_guess.x = (initial_guess.lower + initial_guess.upper) / 2;
 
     try {
-        return cubic_splines::find_parameter(
-                *interpolant_, integrated_to_upper - rnd, initial_guess);
+        return cubic_splines::find_parameter(interpolant, value, initial_guess);
     } catch (std::runtime_error&) {
+        InterpolantFallbacks::ThisThread().utility_bisection++;
         Logging::Get("proposal.UtilityInterpolant")->warn(
                 "Newton-Raphson iteration in UtilityInterpolant::GetUpperLimit "
                 "failed. Try solving using bisection method.");
 
-        return Bisection(f, lower_lim, upper_limit, 1e-6, 100).first;
+        return Bisection(f, lower, upper, 1e-6, 100).first;
     }
 
     // TODO: Check whether this is already accurate enough
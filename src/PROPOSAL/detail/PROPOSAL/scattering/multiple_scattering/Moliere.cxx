@@ -12,7 +12,9 @@
 
 using namespace PROPOSAL::multiple_scattering;
 
-double Moliere::GetPrefactor(double ei, double grammage) {
+double Moliere::GetPrefactor(
+    double ei, double grammage, ScatteringParameters& params)
+{
     double momentum_Sq = (ei - mass) * (ei + mass);
     double beta_Sq = 1. / (1. + mass * mass / momentum_Sq); // beta^2 = (v/c)^2
 
@@ -22,7 +24,9 @@ double Moliere::GetPrefactor(double ei, double grammage) {
 
     double chi_0 = 0.;
 
-    std::vector<double> chi_A_Sq; // screening angle^2 in rad^2
+    // kept per thread like the scattering parameters, so no memory is
+    // allocated per step
+    thread_local std::vector<double> chi_A_Sq; // screening angle^2 in rad^2
     chi_A_Sq.resize(numComp_);
 
     for (int i = 0; i < numComp_; i++) {
@@ -34,11 +38,12 @@ double Moliere::GetPrefactor(double ei, double grammage) {
     }
 
     // Calculate Chi_c^2
-    chiCSq_ = ((4. * PI * NA * ALPHA * ALPHA * HBAR * HBAR * SPEED * SPEED)
+    params.chiCSq = ((4. * PI * NA * ALPHA * ALPHA * HBAR * HBAR * SPEED * SPEED)
                * (grammage) / beta_p_Sq)
               * ZSq_A_average_;
 
     // Calculate B
+    params.B.resize(numComp_);
 
     for (int i = 0; i < numComp_; i++) {
         // calculate B-ln(B) = ln(chi_c^2/chi_a^2)+1-2*EULER_MASCHERONI via
@@ -49,7 +54,7 @@ double Moliere::GetPrefactor(double ei, double grammage) {
             if (xn < 0)
                 return 0; // xn would become nan for further iterations
             xn = xn
-                 * ((1. - std::log(xn) - std::log(chiCSq_ / chi_A_Sq[i]) - 1.
+                 * ((1. - std::log(xn) - std::log(params.chiCSq / chi_A_Sq[i]) - 1.
                      + 2. * EULER_MASCHERONI)
                     / (1. - xn));
         }
@@ -60,10 +65,10 @@ double Moliere::GetPrefactor(double ei, double grammage) {
             return 0;
         }
 
-        B_[i] = xn;
+        params.B[i] = xn;
     }
 
-    double pre_factor = std::sqrt(chiCSq_ * B_[max_weight_index_]);
+    double pre_factor = std::sqrt(params.chiCSq * params.B[max_weight_index_]);
     return pre_factor;
 }
 
@@ -73,19 +78,20 @@ ScatteringOffset Moliere::CalculateRandomAngle(
     (void)ef;
     ScatteringOffset offsets;
 
-    auto pre_factor = GetPrefactor(ei, grammage);
+    thread_local ScatteringParameters params;
+    auto pre_factor = GetPrefactor(ei, grammage, params);
 
     if (pre_factor == 0)
         return offsets;
 
-    auto rnd1 = GetRandom(pre_factor, rnd[0]);
-    auto rnd2 = GetRandom(pre_factor, rnd[1]);
+    auto rnd1 = GetRandom(pre_factor, rnd[0], params);
+    auto rnd2 = GetRandom(pre_factor, rnd[1], params);
 
     offsets.sx = 0.5 * (rnd1 / SQRT3 + rnd2);
     offsets.tx = rnd2;
 
-    rnd1 = GetRandom(pre_factor, rnd[2]);
-    rnd2 = GetRandom(pre_factor, rnd[3]);
+    rnd1 = GetRandom(pre_factor, rnd[2], params);
+    rnd2 = GetRandom(pre_factor, rnd[3], params);
 
     offsets.sy = 0.5 * (rnd1 / SQRT3 + rnd2);
     offsets.ty = rnd2;
@@ -96,24 +102,26 @@ ScatteringOffset Moliere::CalculateRandomAngle(
 double Moliere::CalculateScatteringAngle(double grammage, double ei, double ef, double rnd) {
     (void)ef;
 
-    auto pre_factor = GetPrefactor(ei, grammage);
+    thread_local ScatteringParameters params;
+    auto pre_factor = GetPrefactor(ei, grammage, params);
 
     if (pre_factor == 0)
         return 0;
 
-    return GetRandom(pre_factor, rnd);
+    return GetRandom(pre_factor, rnd, params);
 };
 
 double Moliere::CalculateScatteringAngle2D(double grammage, double ei, double ef, double rnd1, double rnd2) {
     (void)ef;
 
-    auto pre_factor = GetPrefactor(ei, grammage);
+    thread_local ScatteringParameters params;
+    auto pre_factor = GetPrefactor(ei, grammage, params);
 
     if (pre_factor == 0)
         return 0;
 
-    auto angle1 = GetRandom(pre_factor, rnd1);
-    auto angle2 = GetRandom(pre_factor, rnd2);
+    auto angle1 = GetRandom(pre_factor, rnd1, params);
+    auto angle2 = GetRandom(pre_factor, rnd2, params);
 
     return std::sqrt(angle1 * angle1 + angle2 * angle2);
 };
@@ -132,8 +140,6 @@ Moliere::Moliere(const ParticleDef& particle_def, Medium const& medium)
     , weight_ZZ_(numComp_)
     , weight_ZZ_sum_(0.)
     , max_weight_index_(0)
-    , chiCSq_(0.0)
-    , B_(numComp_)
 {
     std::vector<double> Ai(numComp_,
         0); // atomic number of different components
@@ -202,10 +208,6 @@ bool Moliere::compare(const Parametrization& scattering) const
         return false;
     else if (max_weight_index_ != sc->max_weight_index_)
         return false;
-    else if (chiCSq_ != sc->chiCSq_)
-        return false;
-    else if (B_ != sc->B_)
-        return false;
     else
         return true;
 }
@@ -277,15 +279,16 @@ double Moliere::f2M(double x)
 
 //----------------------------------------------------------------------------//
 
-double Moliere::f(double theta)
+double Moliere::f(double theta, const ScatteringParameters& params)
 {
     double y1 = 0;
 
     for (int i = 0; i < numComp_; i++) {
-        double x = theta * theta / (chiCSq_ * B_[i]);
+        double x = theta * theta / (params.chiCSq * params.B[i]);
 
-        y1 += weight_ZZ_[i] / std::sqrt(chiCSq_ * B_[i] * PI)
-            * (std::exp(-x) + f1M(x) / B_[i] + f2M(x) / (B_[i] * B_[i]));
+        y1 += weight_ZZ_[i] / std::sqrt(params.chiCSq * params.B[i] * PI)
+            * (std::exp(-x) + f1M(x) / params.B[i]
+                + f2M(x) / (params.B[i] * params.B[i]));
     }
 
     return y1 * weight_ZZ_sum_;
@@ -359,17 +362,18 @@ double Moliere::F2M(double x)
 
 //----------------------------------------------------------------------------//
 
-double Moliere::F(double theta)
+double Moliere::F(double theta, const ScatteringParameters& params)
 {
     double y1 = 0;
 
     for (int i = 0; i < numComp_; i++) {
-        double x = theta * theta / (chiCSq_ * B_[i]);
+        double x = theta * theta / (params.chiCSq * params.B[i]);
 
         y1 += weight_ZZ_[i]
             * (0.5 * std::erf(std::sqrt(std::max(x, 0.)))
                 + std::sqrt(1. / PI)
-                    * (F1M(x) / B_[i] + F2M(x) / (B_[i] * B_[i])));
+                    * (F1M(x) / params.B[i]
+                        + F2M(x) / (params.B[i] * params.B[i])));
     }
 
     return (theta < 0.) ? (-1.) * y1 * weight_ZZ_sum_ : y1 * weight_ZZ_sum_;
@@ -379,7 +383,8 @@ double Moliere::F(double theta)
 //-------------------------generate random angle------------------------------//
 //----------------------------------------------------------------------------//
 
-double Moliere::GetRandom(double pre_factor, double rnd)
+double Moliere::GetRandom(
+    double pre_factor, double rnd, const ScatteringParameters& params)
 {
     //  Generate random angles following Moliere's distribution by comparing a
     //  uniformly distributed random number with the integral of the
@@ -401,7 +406,7 @@ double Moliere::GetRandom(double pre_factor, double rnd)
     do {
         i++;
         theta_n = theta_np1;
-        theta_np1 = theta_n - (F(theta_n) - rnd) / f(theta_n);
+        theta_np1 = theta_n - (F(theta_n, params) - rnd) / f(theta_n, params);
         if (i == 100) {
             Logging::Get("proposal.scattering")->warn(
                     "Iteration in Moliere::GetRandom did not converge after 100 iterations. "
@@ -7,8 +7,8 @@ double secondaries::PhotoMuPairProductionBurkhardtKelnerKokoulin::Calculatex(
     if (!dndx)
         throw std::logic_error("dndx Interpolant for PhotoMuPairProductionBurkhardtKelnerKokoulinnot defined.");
     for (auto& it : *dndx) {
-        if (comp.GetHash() == it.first) {
-            auto& calc = *std::get<1>(it.second);
+        if (comp.GetHash() == std::get<2>(it)) {
+            auto& calc = *std::get<1>(it);
             auto lim = calc.GetIntegrationLimits(energy);
             auto rate = rnd * calc.Calculate(energy, lim.max);
             auto rho = calc.GetUpperLimit(energy, rate);
@@ -19,8 +19,8 @@ double secondaries::WeakCooperSarkarMertsch::CalculateRelativeLoss(
     if (!dndx)
         throw std::logic_error("dndx Interpolant for WeakInteraction not defined.");
     for (auto& it : *dndx) {
-        if (c.GetHash() == it.first) {
-            auto& calc = *std::get<1>(it.second);
+        if (c.GetHash() == std::get<2>(it)) {
+            auto& calc = *std::get<1>(it);
             auto rate = rnd * calc.Calculate(energy);
             auto v = calc.GetUpperLimit(energy, rate);
             return v;
@@ -7,6 +7,21 @@
 #include "PROPOSAL/geometry/Geometry.h"
 #include "pyPROPOSAL/pyBindings.h"
 
+namespace {
+// Wraps a column of a Secondaries object into a read-only numpy array without
+// copying. The Secondaries object is set as base of the array and therefore
+// kept alive as long as the array is used.
+template <typename T, typename U = T>
+py::array_t<T> column_array(const ColumnView<U>& column, py::handle owner)
+{
+    static_assert(sizeof(T) == sizeof(U), "column type mismatch");
+    auto array = py::array_t<T>(column.size(),
+        reinterpret_cast<const T*>(column.data()), owner);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+} // namespace
+
 #define PARTICLE_DEF(module, cls)                                                    \
     py::class_<cls##Def, ParticleDef, std::shared_ptr<cls##Def>>(module, #cls "Def") \
         .def(py::init<>());                                                          \
@@ -22,6 +37,11 @@ void init_particle(py::module& m) {
                 Get ParticleDef for given particle_type
     )pbdoc");
 
+    m_sub.def("get_ParticleDef_for_name", &ParticleDef::GetParticleDefForName,
+              py::arg("name"), R"pbdoc(
+                Get ParticleDef for given name, e.g. "MuMinus"
+    )pbdoc");
+
     m_sub.doc() = R"pbdoc(
         For each propagation a defined particle is needed.
         You have the possibility to define one by your own or select one of
@@ -522,6 +542,66 @@ void init_particle(py::module& m) {
                 Returns:
                     List of size_t objects, which are hashed to Medium or Component objects. These are the targets that our particle interacted with during propagation.
                 )pbdoc")
+            .def("energy_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetEnergyColumn(), self); },
+                 R"pbdoc(
+                Energies of all particle states of the track (in MeV) as read-only numpy array. The array is a view
+                on the data of the Secondaries object, no values are copied.
+                )pbdoc")
+            .def("time_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetTimeColumn(), self); },
+                 R"pbdoc(
+                Times of all particle states of the track (in s) as read-only numpy array without copy.
+                )pbdoc")
+            .def("propagated_distance_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetPropagatedDistanceColumn(), self); },
+                 R"pbdoc(
+                Propagated distances of all particle states of the track (in cm) as read-only numpy array without copy.
+                )pbdoc")
+            .def("x_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetXColumn(), self); },
+                 R"pbdoc(
+                x coordinates of all particle states of the track (in cm) as read-only numpy array without copy.
+                )pbdoc")
+            .def("y_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetYColumn(), self); },
+                 R"pbdoc(
+                y coordinates of all particle states of the track (in cm) as read-only numpy array without copy.
+                )pbdoc")
+            .def("z_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetZColumn(), self); },
+                 R"pbdoc(
+                z coordinates of all particle states of the track (in cm) as read-only numpy array without copy.
+                )pbdoc")
+            .def("direction_x_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetDirectionXColumn(), self); },
+                 R"pbdoc(
+                x components of the directions of all particle states of the track as read-only numpy array without
+                copy.
+                )pbdoc")
+            .def("direction_y_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetDirectionYColumn(), self); },
+                 R"pbdoc(
+                y components of the directions of all particle states of the track as read-only numpy array without
+                copy.
+                )pbdoc")
+            .def("direction_z_column",
+                 [](py::object self) { return column_array<double>(self.cast<const Secondaries&>().GetDirectionZColumn(), self); },
+                 R"pbdoc(
+                z components of the directions of all particle states of the track as read-only numpy array without
+                copy.
+                )pbdoc")
+            .def("type_column",
+                 [](py::object self) { return column_array<int>(self.cast<const Secondaries&>().GetTypeColumn(), self); },
+                 R"pbdoc(
+                Interaction types of all particle states of the track as read-only numpy array of integers without
+                copy. The integers correspond to the values of :class:`~proposal.particle.Interaction_Type`.
+                )pbdoc")
+            .def("target_hash_column",
+                 [](py::object self) { return column_array<size_t>(self.cast<const Secondaries&>().GetTargetHashColumn(), self); },
+                 R"pbdoc(
+                Target hashes of all particle states of the track as read-only numpy array without copy.
+                )pbdoc")
             .def("stochastic_losses",
                  overload_cast_<>()(&Secondaries::GetStochasticLosses, py::const_),
                  R"pbdoc(
@@ -586,7 +666,7 @@ void init_particle(py::module& m) {
                     geometry: Geometry object, find continuous losses within this geometry
                 )pbdoc")
             .def("decay_products",
-                 &Secondaries::GetDecayProducts,
+                 py::overload_cast<>(&Secondaries::GetDecayProducts, py::const_),
                  R"pbdoc(
                 If the particle has decayed at the end of propagation, this function calculated the decay products as a
                 list of particle states. If the particle did not decay during propagation, the returned list will be
@@ -5,6 +5,7 @@
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/Propagator.h"
 #include "PROPOSAL/math/Spherical3D.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/version.h"
 #include "PROPOSAL/crosssection/CrossSection.h"
 #include "PROPOSAL/density_distr/density_distr.h"
@@ -171,8 +172,14 @@ PYBIND11_MODULE(proposal, m)
         .def("function_to_integral", py::vectorize(&Interaction::FunctionToIntegral),
              py::arg("energy"))
         .def("rates", &Interaction::Rates, py::arg("energy"))
-        .def("sample_loss", &Interaction::SampleLoss, py::arg("energy"),
-            py::arg("rates"), py::arg("random number"))
+        .def("sample_loss",
+            py::overload_cast<double, std::vector<Interaction::Rate> const&,
+                double>(&Interaction::SampleLoss, py::const_),
+            py::arg("energy"), py::arg("rates"), py::arg("random number"))
+        .def("sample_loss",
+            py::overload_cast<double, double>(
+                &Interaction::SampleLoss, py::const_),
+            py::arg("energy"), py::arg("random number"))
         .def("mean_free_path", py::vectorize(&Interaction::MeanFreePath),
             py::arg("energy"));
 
@@ -192,7 +199,7 @@ PYBIND11_MODULE(proposal, m)
 
     py::class_<Interaction::Rate,
             std::shared_ptr<Interaction::Rate>>(m, "InteractionRate")
-            .def_readwrite("comp_hash", &Interaction::Rate::comp_hash)
+            .def_readwrite("comp_index", &Interaction::Rate::comp_index)
             .def_readwrite("crosssection", &Interaction::Rate::crosssection)
             .def_readwrite("rate", &Interaction::Rate::rate);
 
@@ -224,6 +231,10 @@ PYBIND11_MODULE(proposal, m)
         m, "InterpolationSettings")
         .def_readwrite_static(
             "tables_path", &InterpolationSettings::TABLES_PATH)
+        .def_readwrite_static(
+            "tables_archive", &InterpolationSettings::TABLES_ARCHIVE)
+        .def_readwrite_static(
+            "archive_float_precision", &InterpolationSettings::ARCHIVE_FLOAT_PRECISION)
         .def_readwrite_static(
             "upper_energy_lim", &InterpolationSettings::UPPER_ENERGY_LIM)
         .def_readwrite_static("nodes_dedx", &InterpolationSettings::NODES_DEDX)
@@ -235,7 +246,30 @@ PYBIND11_MODULE(proposal, m)
         .def_readwrite_static(
             "nodes_utility", &InterpolationSettings::NODES_UTILITY)
         .def_readwrite_static(
-            "nodes_rate_interpolant", &InterpolationSettings::NODES_RATE_INTERPOLANT);
+            "nodes_rate_interpolant", &InterpolationSettings::NODES_RATE_INTERPOLANT)
+        .def_readwrite_static(
+            "table_build_threads", &InterpolationSettings::TABLE_BUILD_THREADS)
+        .def_readwrite_static(
+            "lazy_tables", &InterpolationSettings::LAZY_TABLES)
+        .def_readwrite_static("precompute_lazy_tables",
+            &InterpolationSettings::PRECOMPUTE_LAZY_TABLES)
+        .def_readwrite_static(
+            "segment_decades", &InterpolationSettings::SEGMENT_DECADES)
+        .def_readwrite_static(
+            "table_tolerance", &InterpolationSettings::TABLE_TOLERANCE)
+        .def_readwrite_static(
+            "nodes_channel_table", &InterpolationSettings::NODES_CHANNEL_TABLE)
+        .def_readwrite_static(
+            "dndx_inverse_tables", &InterpolationSettings::DNDX_INVERSE_TABLES)
+        .def_readwrite_static(
+            "utility_inverse_tables", &InterpolationSettings::UTILITY_INVERSE_TABLES);
+
+    m.def("write_table_archive", &TableArchive::WritePending,
+        R"pbdoc(
+            Add all tables built since the last call to the archive configured
+            by InterpolationSettings.tables_archive. The Propagator does this
+            on construction.
+        )pbdoc");
 
     py::class_<PropagationSettings, std::shared_ptr<PropagationSettings>>(
             m, "PropagationSettings")
@@ -451,13 +485,95 @@ PYBIND11_MODULE(proposal, m)
             "get", &RandomGenerator::Get,
     py::return_value_policy::reference);
 
+    py::enum_<TrackRecording>(m, "TrackRecording")
+        .value("full", TrackRecording::Full)
+        .value("stochastic_losses", TrackRecording::StochasticLosses)
+        .value("endpoints", TrackRecording::Endpoints);
+
+    py::class_<PropagationStatistics>(m, "PropagationStatistics")
+        .def_readonly("propagations", &PropagationStatistics::propagations)
+        .def_readonly("advance_particle_calls", &PropagationStatistics::advance_particle_calls)
+        .def_readonly("advance_particle_iterations", &PropagationStatistics::advance_particle_iterations)
+        .def_readonly("advance_particle_max_iterations", &PropagationStatistics::advance_particle_max_iterations)
+        .def_readonly("invalid_steps", &PropagationStatistics::invalid_steps)
+        .def_readonly("backscatter_resamples", &PropagationStatistics::backscatter_resamples)
+        .def_readonly("unreachable_step_resamples", &PropagationStatistics::unreachable_step_resamples)
+        .def_readonly("max_steps_reached", &PropagationStatistics::max_steps_reached)
+        .def_readonly("density_exception_fallbacks", &PropagationStatistics::density_exception_fallbacks)
+        .def_readonly("utility_bisection_fallbacks", &PropagationStatistics::utility_bisection_fallbacks)
+        .def_readonly("dndx_bisection_fallbacks", &PropagationStatistics::dndx_bisection_fallbacks)
+        .def("__str__", &py_print<PropagationStatistics>);
+
+    py::class_<PropagationProfile>(m, "PropagationProfile")
+        .def_readonly("propagations", &PropagationProfile::propagations)
+        .def_readonly("total_seconds", &PropagationProfile::total_seconds)
+        .def_property_readonly_static("enabled",
+            [](py::object) { return PropagationProfile::IsEnabled(); })
+        .def_property_readonly("phases",
+            [](const PropagationProfile& profile) {
+                py::dict phases;
+                for (size_t i = 0; i < PropagationProfile::NumberOfPhases; ++i)
+                    phases[PropagationProfile::GetPhaseName(i)]
+                        = py::make_tuple(profile.calls[i], profile.seconds[i]);
+                return phases;
+            },
+            R"pbdoc(
+                Dictionary of phase name to (number of calls, wall time in s).
+            )pbdoc")
+        .def("__str__", &py_print<PropagationProfile>);
+
     py::class_<Propagator, std::shared_ptr<Propagator>>(m, "Propagator")
         .def(py::init<const ParticleDef&, std::vector<Sector>>())
         .def(py::init<const ParticleDef&, const std::string&>(),
             py::arg("particle_def"), py::arg("path_to_config_file"))
-        .def("propagate", &Propagator::Propagate, py::arg("initial_particle"),
+        .def("propagate", py::overload_cast<const ParticleState&, double, double, unsigned int>(&Propagator::Propagate), py::arg("initial_particle"),
+            py::arg("max_distance") = 1.e20, py::arg("min_energy") = 0.,
+            py::arg("hierarchy_condition") = 0)
+        .def("propagate", py::overload_cast<const ParticleState&, Secondaries&, double, double, unsigned int>(&Propagator::Propagate),
+            py::arg("initial_particle"), py::arg("secondaries"),
             py::arg("max_distance") = 1.e20, py::arg("min_energy") = 0.,
-            py::arg("hierarchy_condition") = 0);
+            py::arg("hierarchy_condition") = 0,
+            R"pbdoc(
+                Propagate a particle into an existing secondaries object. The
+                object is reset but keeps its allocated memory, so it can be
+                reused for many events.
+            )pbdoc")
+        .def_property("collect_statistics", &Propagator::GetCollectStatistics,
+            &Propagator::SetCollectStatistics,
+            R"pbdoc(
+                Enable the collection of hot path counters of the propagation,
+                which can be read with statistics().
+            )pbdoc")
+        .def("statistics", &Propagator::GetStatistics,
+            R"pbdoc(
+                Counters of all propagations since the collection has been
+                enabled or the statistics have been reset.
+            )pbdoc")
+        .def("reset_statistics", &Propagator::ResetStatistics)
+        .def("profile", &Propagator::GetProfile,
+            R"pbdoc(
+                Wall time and calls of the phases of the propagation loop.
+                Only filled if PROPOSAL has been built with
+                PROPOSAL_PROFILING.
+            )pbdoc")
+        .def("reset_profile", &Propagator::ResetProfile)
+        .def_property("track_recording", &Propagator::GetTrackRecording,
+            &Propagator::SetTrackRecording,
+            R"pbdoc(
+                States stored in the secondaries returned by propagate: the
+                full track, only stochastic losses or only the endpoints.
+            )pbdoc")
+        .def("propagate_batch", &Propagator::PropagateBatch,
+            py::arg("initial_particles"), py::arg("seed"),
+            py::arg("n_threads") = 0, py::arg("max_distance") = 1.e20,
+            py::arg("min_energy") = 0., py::arg("hierarchy_condition") = 0,
+            py::call_guard<py::gil_scoped_release>(),
+            R"pbdoc(
+                Propagate a list of particles with a pool of worker threads.
+                Every event gets its own random stream derived from the seed
+                and its index, so the results do not depend on n_threads.
+                The secondaries are returned in the order of the input.
+            )pbdoc");
 
     /* py::class_<PropagatorService, std::shared_ptr<PropagatorService>>( */
     /*     m, "PropagatorService") */
@@ -0,0 +1,286 @@
+/*
+ * Measures the startup time of PROPOSAL, i.e. the construction of a
+ * propagator for each given configuration and of the single table builders,
+ * once without any tables (cold) and once with the tables written by the
+ * first run (warm). Each measurement uses its own temporary tables path,
+ * which is removed afterwards. The results are written as JSON.
+ *
+ * Usage: proposal_benchmark [options] <config.json>...
+ */
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/PROPOSAL.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/TableArchive.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace PROPOSAL;
+
+namespace {
+void PrintUsage(std::ostream& out)
+{
+    out << "Usage: proposal_benchmark [options] <config.json>...\n"
+           "\n"
+           "Measures the construction time of a propagator for each\n"
+           "configuration and of the single table builders, without tables\n"
+           "(cold) and with the tables of the previous run (warm).\n"
+           "\n"
+           "Options:\n"
+           "  --particle <name>            particle to propagate\n"
+           "                               (default: MuMinus)\n"
+           "  --repetitions <n>            measurements per entry (default: 1)\n"
+           "  --lazy                       build the tables on first use\n"
+           "                               instead of on construction\n"
+           "  --tmp <dir>                  directory for the temporary tables\n"
+           "                               (default: /tmp, %TEMP% on\n"
+           "                               Windows)\n"
+           "  --output <file>              write the results to this file\n"
+           "                               instead of stdout\n"
+           "  -h, --help                   print this message\n";
+}
+
+std::string DefaultTemporaryPath()
+{
+#ifdef _WIN32
+    auto temp = std::getenv("TEMP");
+    return temp ? temp : ".";
+#else
+    return "/tmp";
+#endif
+}
+
+// creates a directory with a unique name from pattern, whose last six
+// characters have to be XXXXXX and are replaced
+bool MakeTemporaryDirectory(std::string& pattern)
+{
+#ifdef _WIN32
+    return _mktemp_s(&pattern[0], pattern.size() + 1) == 0
+        && _mkdir(pattern.c_str()) == 0;
+#else
+    return mkdtemp(&pattern[0]) != nullptr;
+#endif
+}
+
+bool RemoveTemporaryDirectory(std::string const& path)
+{
+#ifdef _WIN32
+    return _rmdir(path.c_str()) == 0;
+#else
+    return rmdir(path.c_str()) == 0;
+#endif
+}
+
+/*!
+ * Temporary tables path of one measurement. All tables written or read
+ * while it exists are removed together with the directory on destruction.
+ */
+class TablesDirectory {
+    std::string path;
+
+public:
+    explicit TablesDirectory(std::string const& tmp)
+    {
+        auto pattern = tmp + "/proposal_benchmark_XXXXXX";
+        if (!MakeTemporaryDirectory(pattern))
+            throw std::runtime_error(
+                "Unable to create a temporary directory in " + tmp);
+        path = pattern;
+        InterpolationSettings::TABLES_PATH = path;
+        TableArchive::TakeCreationTimes();
+    }
+
+    ~TablesDirectory()
+    {
+        for (auto const& time : TableArchive::TakeCreationTimes())
+            std::remove((path + "/" + time.name).c_str());
+        if (!RemoveTemporaryDirectory(path))
+            std::cerr << "Unable to remove " << path << "\n";
+    }
+
+    TablesDirectory(TablesDirectory const&) = delete;
+    TablesDirectory& operator=(TablesDirectory const&) = delete;
+};
+
+double Seconds(std::function<void()> const& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+/*!
+ * Measures the callable returned by setup without tables and again with the
+ * tables the first call wrote. The setup itself, e.g. building the cross
+ * sections a builder depends on, is not measured.
+ */
+nlohmann::json Measure(std::string const& tmp, unsigned int repetitions,
+    std::function<std::function<void()>()> const& setup)
+{
+    auto cold = std::vector<double>();
+    auto warm = std::vector<double>();
+    for (auto i = 0u; i < repetitions; ++i) {
+        TablesDirectory directory(tmp);
+        InterpolantRegistry::Clear();
+        auto build = setup();
+        InterpolantRegistry::Clear();
+        cold.push_back(Seconds(build));
+        InterpolantRegistry::Clear();
+        warm.push_back(Seconds(build));
+        InterpolantRegistry::Clear();
+    }
+    return { { "cold_seconds", cold }, { "warm_seconds", warm } };
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto particle_name = std::string("MuMinus");
+    auto repetitions = 1u;
+    auto tmp = DefaultTemporaryPath();
+    auto output = std::string();
+    auto configs = std::vector<std::string>();
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        auto value = [&]() {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value of " << arg << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+            return std::string(argv[++i]);
+        };
+        auto number = [&](auto convert) {
+            auto text = value();
+            try {
+                return convert(text);
+            } catch (const std::logic_error&) {
+                std::cerr << "Invalid value " << text << " of " << arg
+                          << "\n\n";
+                PrintUsage(std::cerr);
+                std::exit(EXIT_FAILURE);
+            }
+        };
+        if (arg == "-h" || arg == "--help") {
+            PrintUsage(std::cout);
+            return EXIT_SUCCESS;
+        } else if (arg == "--particle") {
+            particle_name = value();
+        } else if (arg == "--repetitions") {
+            repetitions = number(
+                [](const std::string& s) { return std::stoul(s); });
+        } else if (arg == "--lazy") {
+            InterpolationSettings::LAZY_TABLES = true;
+        } else if (arg == "--tmp") {
+            tmp = value();
+        } else if (arg == "--output") {
+            output = value();
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "Unknown option " << arg << "\n\n";
+            PrintUsage(std::cerr);
+            return EXIT_FAILURE;
+        } else {
+            configs.push_back(arg);
+        }
+    }
+    if (configs.empty() || repetitions == 0) {
+        PrintUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    // tables are only written to the temporary tables paths
+    InterpolationSettings::TABLES_ARCHIVE = "";
+
+    auto results = nlohmann::json::object();
+    try {
+        auto p_def = ParticleDef::GetParticleDefForName(particle_name);
+        results["version"] = getPROPOSALVersion();
+        results["particle"] = p_def.name;
+        results["repetitions"] = repetitions;
+        results["lazy_tables"] = InterpolationSettings::LAZY_TABLES;
+
+        auto propagator = nlohmann::json::array();
+        for (auto const& config : configs) {
+            std::cerr << "Propagator " << config << "\n";
+            auto timing = Measure(tmp, repetitions, [&]() {
+                return [&]() { Propagator(p_def, config); };
+            });
+            timing["config"] = config;
+            propagator.push_back(timing);
+        }
+        results["propagator"] = propagator;
+
+        // the builders are measured for the interpolated standard cross
+        // sections of the particle in ice
+        auto medium = Ice();
+        auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+        auto brems = crosssection::BremsKelnerKokoulinPetrukhin(false);
+        auto cross = [&]() {
+            return GetStdCrossSections(p_def, medium, cuts, true);
+        };
+
+        auto builders = nlohmann::json::object();
+        std::cerr << "Builders\n";
+        builders["CrossSectionDNDXInterpolant"]
+            = Measure(tmp, repetitions, [&]() {
+                  return [&]() {
+                      CrossSectionDNDXInterpolant(brems, p_def,
+                          medium.GetComponents().front(), cuts);
+                  };
+              });
+        builders["CrossSectionDEDXInterpolant"]
+            = Measure(tmp, repetitions, [&]() {
+                  return [&]() {
+                      CrossSectionDEDXInterpolant(
+                          brems, p_def, medium.GetComponents().front(), *cuts);
+                  };
+              });
+        builders["DisplacementBuilder"] = Measure(tmp, repetitions, [&]() {
+            return [c = cross()]() { make_displacement(c, true); };
+        });
+        builders["InteractionBuilder::InitializeRateInterpolant"]
+            = Measure(tmp, repetitions, [&]() {
+                  auto c = cross();
+                  auto disp = std::shared_ptr<Displacement>(
+                      make_displacement(c, false));
+                  return [c, disp]() { make_interaction(disp, c, false, true); };
+              });
+        builders["MoliereInterpol"] = Measure(tmp, repetitions, [&]() {
+            return [&]() { make_moliereinterpol(p_def, medium); };
+        });
+        results["builders"] = builders;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (output.empty()) {
+        std::cout << results.dump(4) << "\n";
+    } else {
+        std::ofstream file(output);
+        file << results.dump(4) << "\n";
+        if (!file) {
+            std::cerr << "Unable to write " << output << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * Builds all interpolation tables a propagator configuration requires for
+ * the given particles without propagating anything, e.g. to store them in a
+ * container image. The tables are written to the tables path or the archive
+ * and the time spent per table is reported.
+ *
+ * Usage: proposal_build_tables [options] <config.json> <particle>...
+ */
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Propagator.h"
+#include "PROPOSAL/math/TableArchive.h"
+#include "PROPOSAL/particle/ParticleDef.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace PROPOSAL;
+
+namespace {
+void PrintUsage(std::ostream& out)
+{
+    out << "Usage: proposal_build_tables [options] <config.json> <particle>...\n"
+           "\n"
+           "Builds the interpolation tables required by the propagator\n"
+           "configuration for the given particles, e.g. MuMinus TauMinus.\n"
+           "\n"
+           "Options:\n"
+           "  --tables-path <dir>          directory of the table files\n"
+           "                               (default: " << InterpolationSettings::TABLES_PATH << ")\n"
+           "  --archive <file>             write the tables to this archive\n"
+           "                               instead of single files\n"
+           "  --float-precision <prec>     archive tables as float if their\n"
+           "                               values are within this precision\n"
+           "  --lazy                       build the segments used with\n"
+           "                               lazy_tables, which are named\n"
+           "                               differently than the full tables\n"
+           "  --threads <n>                threads to build the tables with,\n"
+           "                               0 for one per core (default: 0)\n"
+           "  -h, --help                   print this message\n";
+}
+
+void PrintTimes(std::vector<TableArchive::CreationTime> times)
+{
+    std::sort(times.begin(), times.end(),
+        [](TableArchive::CreationTime const& a,
+            TableArchive::CreationTime const& b) {
+            return a.seconds > b.seconds;
+        });
+    auto created = 0;
+    for (auto const& time : times) {
+        std::cout << "    " << std::setw(10) << std::fixed
+                  << std::setprecision(3) << time.seconds << " s  "
+                  << (time.created ? "created " : "read    ") << time.name
+                  << "\n";
+        created += time.created;
+    }
+    std::cout << "    " << created << " of " << times.size()
+              << " tables created\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto positional = std::vector<std::string>();
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        auto value = [&]() {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value of " << arg << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+            return std::string(argv[++i]);
+        };
+        auto number = [&](auto convert) {
+            auto text = value();
+            try {
+                return convert(text);
+            } catch (const std::logic_error&) {
+                std::cerr << "Invalid value " << text << " of " << arg
+                          << "\n\n";
+                PrintUsage(std::cerr);
+                std::exit(EXIT_FAILURE);
+            }
+        };
+        if (arg == "-h" || arg == "--help") {
+            PrintUsage(std::cout);
+            return EXIT_SUCCESS;
+        } else if (arg == "--tables-path") {
+            InterpolationSettings::TABLES_PATH = value();
+        } else if (arg == "--archive") {
+            InterpolationSettings::TABLES_ARCHIVE = value();
+        } else if (arg == "--float-precision") {
+            InterpolationSettings::ARCHIVE_FLOAT_PRECISION = number(
+                [](const std::string& s) { return std::stod(s); });
+        } else if (arg == "--lazy") {
+            InterpolationSettings::LAZY_TABLES = true;
+        } else if (arg == "--threads") {
+            InterpolationSettings::TABLE_BUILD_THREADS = number(
+                [](const std::string& s) { return std::stoul(s); });
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "Unknown option " << arg << "\n\n";
+            PrintUsage(std::cerr);
+            return EXIT_FAILURE;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() < 2) {
+        PrintUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    // all tables have to be built now, but segmented like the tables of the
+    // configured mode, so they are found under the same names later
+    InterpolationSettings::PRECOMPUTE_LAZY_TABLES = true;
+
+    auto config_file = positional.front();
+    auto particles = std::vector<ParticleDef>();
+    try {
+        for (auto it = positional.begin() + 1; it != positional.end(); ++it)
+            particles.push_back(ParticleDef::GetParticleDefForName(*it));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto const& p_def : particles) {
+        std::cout << p_def.name << "\n";
+        auto particle_start = std::chrono::steady_clock::now();
+        try {
+            // the propagator builds its tables concurrently and adds them to
+            // the archive, if there is one
+            Propagator propagator(p_def, config_file);
+        } catch (const std::exception& e) {
+            std::cerr << "Unable to build the tables of " << p_def.name
+                      << ": " << e.what() << "\n";
+            return EXIT_FAILURE;
+        }
+        PrintTimes(TableArchive::TakeCreationTimes());
+        std::cout << "    " << std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - particle_start)
+                         .count()
+                  << " s in total\n";
+    }
+    std::cout << "Built the tables of " << particles.size() << " particles in "
+              << std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count()
+              << " s.\n";
+    return EXIT_SUCCESS;
+}
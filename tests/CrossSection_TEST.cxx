@@ -1,7 +1,26 @@
 #include "gtest/gtest.h"
 
 #include "PROPOSAL/crosssection/parametrization/EpairProduction.h"
+#include "PROPOSAL/crosssection/parametrization/Bremsstrahlung.h"
+#include "PROPOSAL/crosssection/parametrization/Ionization.h"
 #include "PROPOSAL/crosssection/CrossSectionBuilder.h"
+#include "PROPOSAL/crosssection/CrossSectionDNDX/CrossSectionDNDXInterpolant.h"
+#include "PROPOSAL/crosssection/ParticleDefaultCrossSectionList.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/NodeRefinement.h"
+#include "PROPOSAL/math/SegmentedTable.h"
+#include "PROPOSAL/math/TableArchive.h"
+#include "PROPOSAL/math/TableLock.h"
+#include "PROPOSAL/Constants.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace PROPOSAL;
 
@@ -29,6 +48,435 @@ TEST(CalculateStochasticLoss, GetUpperLimit_Exception)
                 rate_failed, rate_failed*1e-5);
 }
 
+TEST(CrossSection, ComponentIndex)
+{
+    auto medium = StandardRock();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto cross = make_crosssection(
+        crosssection::BremsKelnerKokoulinPetrukhin(false), MuMinusDef(),
+        medium, cuts, false);
+
+    auto components = medium.GetComponents();
+    ASSERT_EQ(cross->GetNumComponents(), components.size());
+
+    auto energy = 1e5;
+    auto sum = 0.;
+    auto per_target = cross->CalculatedNdx_PerTarget(energy);
+    for (size_t i = 0; i < cross->GetNumComponents(); ++i) {
+        auto comp_hash = cross->GetComponentHash(i);
+        EXPECT_EQ(comp_hash, components[i].GetHash());
+        EXPECT_EQ(per_target[i].first, comp_hash);
+
+        auto rate = cross->CalculatedNdx_ByIndex(energy, i);
+        EXPECT_DOUBLE_EQ(rate, cross->CalculatedNdx(energy, comp_hash));
+        EXPECT_DOUBLE_EQ(rate, per_target[i].second);
+        EXPECT_DOUBLE_EQ(cross->CalculateStochasticLoss_ByIndex(i, energy, 0.5 * rate),
+            cross->CalculateStochasticLoss(comp_hash, energy, 0.5 * rate));
+        sum += rate;
+    }
+    EXPECT_NEAR(sum, cross->CalculatedNdx(energy), 1e-10 * sum);
+    EXPECT_THROW(cross->CalculatedNdx(energy, medium.GetHash()),
+        std::out_of_range);
+}
+
+TEST(TableArchive, WriteAndRead)
+{
+    auto file = testing::TempDir() + "proposal_archive_test.pta";
+    auto tables = std::map<std::string, TableArchive::TableData>();
+    tables["a"].nodes = { { 3, 1 } };
+    tables["a"].values = { 1., 2., 3. };
+    tables["a"].derivatives = { 4., 5., 6. };
+    tables["table_b"].nodes = { { 2, 2 } };
+    tables["table_b"].values = { 7., 8., 9., 10. };
+    TableArchive::Write(file, tables);
+
+    auto archive = TableArchive(file);
+    EXPECT_EQ(archive.size(), 2);
+    EXPECT_EQ(archive.Find("c"), nullptr);
+    auto a = archive.Find("a");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->nodes[0], 3);
+    EXPECT_FALSE(a->single_precision);
+    EXPECT_TRUE(a->IsIntact());
+    EXPECT_EQ(a->Value(2), 3.);
+    EXPECT_EQ(a->Derivative(0), 4.);
+    auto b = archive.Find("table_b");
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->nodes[1], 2);
+    EXPECT_EQ(b->Value(3), 10.);
+    EXPECT_EQ(b->derivatives, nullptr);
+
+    std::ofstream(file) << "not an archive";
+    EXPECT_THROW(TableArchive archive_invalid(file), std::runtime_error);
+    std::remove(file.c_str());
+}
+
+TEST(TableArchive, SinglePrecision)
+{
+    auto file = testing::TempDir() + "proposal_archive_float_test.pta";
+    auto tables = std::map<std::string, TableArchive::TableData>();
+    tables["float"].nodes = { { 3, 1 } };
+    tables["float"].axes = { { { { 1., 1e5 } } } };
+    tables["float"].values = { 1.1, 2.2, 3.3 };
+    tables["double"].nodes = { { 2, 1 } };
+    tables["double"].values = { 1., 1e-300 }; // not representable as float
+
+    InterpolationSettings::ARCHIVE_FLOAT_PRECISION = 1e-6;
+    TableArchive::Write(file, tables);
+    InterpolationSettings::ARCHIVE_FLOAT_PRECISION = 0.;
+
+    auto archive = TableArchive(file);
+    auto single = archive.Find("float");
+    ASSERT_NE(single, nullptr);
+    EXPECT_TRUE(single->single_precision);
+    EXPECT_EQ(single->size, 3 * sizeof(float));
+    EXPECT_DOUBLE_EQ(single->axes[0][1], 1e5);
+    EXPECT_NEAR(single->Value(1), 2.2, 2.2e-6);
+    auto full = archive.Find("double");
+    ASSERT_NE(full, nullptr);
+    EXPECT_FALSE(full->single_precision);
+    EXPECT_EQ(full->Value(1), 1e-300);
+    std::remove(file.c_str());
+}
+
+TEST(TableArchive, CrossSectionFromArchive)
+{
+    auto file = testing::TempDir() + "proposal_crosssection_test.pta";
+    std::remove(file.c_str());
+    InterpolationSettings::TABLES_ARCHIVE = file;
+    InterpolantRegistry::Clear();
+
+    auto param = crosssection::BremsKelnerKokoulinPetrukhin(false);
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto built = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    TableArchive::WritePending();
+
+    auto archive = TableArchive::Get();
+    ASSERT_NE(archive, nullptr);
+    EXPECT_GT(archive->size(), 0);
+
+    InterpolantRegistry::Clear();
+    auto read = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    for (auto energy : { 1e3, 1e5, 1e8, 1e11 }) {
+        EXPECT_DOUBLE_EQ(read->CalculatedEdx(energy), built->CalculatedEdx(energy));
+        EXPECT_DOUBLE_EQ(read->CalculatedNdx(energy), built->CalculatedNdx(energy));
+    }
+
+    InterpolationSettings::TABLES_ARCHIVE = "";
+    std::remove(file.c_str());
+}
+
+TEST(TableArchive, CrossSectionFromFloatArchive)
+{
+    auto file = testing::TempDir() + "proposal_crosssection_float_test.pta";
+    std::remove(file.c_str());
+    InterpolationSettings::TABLES_ARCHIVE = file;
+    InterpolationSettings::ARCHIVE_FLOAT_PRECISION = 1e-6;
+    InterpolantRegistry::Clear();
+
+    auto param = crosssection::BremsKelnerKokoulinPetrukhin(false);
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto built = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    TableArchive::WritePending();
+    InterpolationSettings::ARCHIVE_FLOAT_PRECISION = 0.;
+
+    auto archive = TableArchive::Get();
+    ASSERT_NE(archive, nullptr);
+    for (auto& name : archive->GetNames())
+        EXPECT_TRUE(archive->Find(name)->single_precision);
+
+    InterpolantRegistry::Clear();
+    auto read = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    for (auto energy : { 1e3, 1e5, 1e8, 1e11 }) {
+        EXPECT_NEAR(read->CalculatedEdx(energy), built->CalculatedEdx(energy),
+            built->CalculatedEdx(energy) * 1e-5);
+        EXPECT_NEAR(read->CalculatedNdx(energy), built->CalculatedNdx(energy),
+            built->CalculatedNdx(energy) * 1e-5);
+    }
+
+    InterpolantRegistry::Clear();
+    InterpolationSettings::TABLES_ARCHIVE = "";
+    std::remove(file.c_str());
+}
+
+#ifndef _WIN32
+TEST(TableLock, ExclusiveBetweenProcesses)
+{
+    auto table = std::string("/tmp/unittest_table_lock.dat");
+    auto marker = table + ".released";
+    std::remove(marker.c_str());
+
+    auto pid = pid_t();
+    {
+        TableLock lock(table);
+        pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            // the lock can only be taken after the parent has released it
+            auto released = false;
+            {
+                TableLock child_lock(table);
+                released = std::ifstream(marker).good();
+            }
+            _exit(released ? 0 : 1);
+        }
+        usleep(200000);
+        std::ofstream(marker) << "released";
+    }
+
+    auto status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_FALSE(std::ifstream(table + ".lock").good());
+    std::remove(marker.c_str());
+}
+#endif
+
+TEST(InterpolantRegistry, SharesInterpolants)
+{
+    InterpolantRegistry::Clear();
+    auto builds = 0;
+    auto build = [&builds]() {
+        builds++;
+        return std::make_shared<double>(1.);
+    };
+    auto a = InterpolantRegistry::Get<double>("a", build);
+    auto b = InterpolantRegistry::Get<double>("a", build);
+    auto c = InterpolantRegistry::Get<double>("c", build);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(InterpolantRegistry::size(), 2);
+    EXPECT_THROW(InterpolantRegistry::Get<int>(
+                     "a", []() { return std::make_shared<int>(1); }),
+        std::logic_error);
+
+    // interpolants are released with the last object using them
+    a.reset();
+    b.reset();
+    EXPECT_FALSE(InterpolantRegistry::Contains("a"));
+    EXPECT_TRUE(InterpolantRegistry::Contains("c"));
+    InterpolantRegistry::Get<double>("a", build);
+    EXPECT_EQ(builds, 3);
+}
+
+TEST(InterpolantRegistry, SharesCrossSectionTables)
+{
+    InterpolantRegistry::Clear();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto param = crosssection::IonizBetheBlochRossi(*cuts);
+    auto first = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    auto n_tables = InterpolantRegistry::size();
+    EXPECT_GT(n_tables, 0);
+
+    auto second = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    EXPECT_EQ(InterpolantRegistry::size(), n_tables);
+    for (auto energy : { 1e3, 1e6, 1e9 }) {
+        EXPECT_DOUBLE_EQ(first->CalculatedEdx(energy), second->CalculatedEdx(energy));
+        EXPECT_DOUBLE_EQ(first->CalculatedNdx(energy), second->CalculatedNdx(energy));
+    }
+
+    // different media require different tables
+    auto third = make_crosssection(param, MuMinusDef(), Ice(), cuts, true);
+    EXPECT_GT(InterpolantRegistry::size(), n_tables);
+}
+
+TEST(SegmentedTable, Segmentation)
+{
+    InterpolationSettings::LAZY_TABLES = false;
+    auto full = EnergySegmentation(105., 1e14, 100, 42);
+    ASSERT_EQ(full.size(), 1);
+    EXPECT_EQ(full.GetSegment(0).hash, 42);
+    EXPECT_EQ(full.GetSegment(0).nodes, 100);
+
+    InterpolationSettings::LAZY_TABLES = true;
+    auto segments = EnergySegmentation(105., 1e14, 100, 42);
+    ASSERT_EQ(segments.size(), 6);
+    EXPECT_DOUBLE_EQ(segments.GetLow(), 105.);
+    EXPECT_DOUBLE_EQ(segments.GetSegment(0).up, 1e4);
+    EXPECT_DOUBLE_EQ(segments.GetSegment(1).low, 1e4);
+    EXPECT_DOUBLE_EQ(segments.GetUp(), 1e14);
+    EXPECT_NE(segments.GetSegment(0).hash, segments.GetSegment(1).hash);
+    EXPECT_EQ(segments.Find(50.), 0);
+    EXPECT_EQ(segments.Find(1e4), 1);
+    EXPECT_EQ(segments.Find(1e5), 1);
+    EXPECT_EQ(segments.Find(1e15), 5);
+    InterpolationSettings::LAZY_TABLES = false;
+}
+
+TEST(SegmentedTable, LazyCrossSection)
+{
+    InterpolantRegistry::Clear();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto param = crosssection::IonizBetheBlochRossi(*cuts);
+    auto full = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+
+    InterpolantRegistry::Clear();
+    InterpolationSettings::LAZY_TABLES = true;
+    auto lazy = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    InterpolationSettings::LAZY_TABLES = false;
+
+    // only the segments of the requested energies are built
+    EXPECT_DOUBLE_EQ(lazy->GetLowerEnergyLim(), full->GetLowerEnergyLim());
+    auto n_tables = InterpolantRegistry::size();
+    lazy->CalculatedEdx(1e3);
+    lazy->CalculatedNdx(1e3);
+    EXPECT_EQ(InterpolantRegistry::size(), n_tables + 2);
+    lazy->CalculatedEdx(2e3);
+    lazy->CalculatedNdx(2e3);
+    EXPECT_EQ(InterpolantRegistry::size(), n_tables + 2);
+
+    for (auto energy : { 1e3, 1e5, 1e8, 1e11 }) {
+        EXPECT_NEAR(lazy->CalculatedEdx(energy), full->CalculatedEdx(energy),
+            full->CalculatedEdx(energy) * 1e-3);
+        EXPECT_NEAR(lazy->CalculatedNdx(energy), full->CalculatedNdx(energy),
+            full->CalculatedNdx(energy) * 1e-3);
+    }
+}
+
+TEST(CrossSectionDNDXInterpolant, InverseTables)
+{
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto param = crosssection::BremsKelnerKokoulinPetrukhin(false);
+    auto medium = Water();
+    auto newton = make_crosssection(param, MuMinusDef(), medium, cuts, true);
+    InterpolationSettings::DNDX_INVERSE_TABLES = true;
+    auto inverse = make_crosssection(param, MuMinusDef(), medium, cuts, true);
+    InterpolationSettings::DNDX_INVERSE_TABLES = false;
+
+    for (auto& comp : medium.GetComponents()) {
+        auto comp_hash = comp.GetHash();
+        for (auto energy : { 1e3, 1e5, 1e8, 1e11 }) {
+            auto rate = newton->CalculatedNdx(energy, comp_hash);
+            for (auto fraction : { 0.01, 0.1, 0.5, 0.9, 0.99 }) {
+                auto v = newton->CalculateStochasticLoss(
+                    comp_hash, energy, fraction * rate);
+                EXPECT_NEAR(inverse->CalculateStochasticLoss(
+                                comp_hash, energy, fraction * rate),
+                    v, v * 1e-6);
+            }
+        }
+    }
+}
+
+TEST(NodeRefinement, Candidates)
+{
+    auto segment = EnergySegmentation::Segment { 1e3, 1e5, 5, 42, 1e-4, 40 };
+    auto candidates = NodeRefinement::Candidates(segment);
+    ASSERT_EQ(candidates.size(), 4);
+    EXPECT_EQ(candidates[0].nodes, 5);
+    EXPECT_EQ(candidates[3].nodes, 33);
+    EXPECT_NE(candidates[0].hash, candidates[1].hash);
+
+    // a smooth function needs fewer nodes than a rapidly changing one
+    auto nodes_for = [&segment](std::function<double(double)> f) {
+        auto create = [f](EnergySegmentation::Segment const& s) {
+            auto def = cubic_splines::CubicSplines<double>::Definition();
+            def.f = f;
+            def.axis = std::make_unique<cubic_splines::ExpAxis<double>>(
+                s.low, s.up, s.nodes);
+            return def;
+        };
+        return NodeRefinement::Refine(segment, create, [](size_t hash) {
+            return "unittest_refinement_" + std::to_string(hash);
+        }).nodes;
+    };
+    auto smooth = nodes_for([](double E) { return std::log(E); });
+    auto sharp = nodes_for([](double E) { return std::sin(E / 1e3); });
+    EXPECT_LT(smooth, sharp);
+}
+
+TEST(NodeRefinement, CrossSectionTolerance)
+{
+    InterpolantRegistry::Clear();
+    InterpolationSettings::TABLE_TOLERANCE = 1e-4;
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto param = crosssection::IonizBetheBlochRossi(*cuts);
+    auto table = make_crosssection(param, MuMinusDef(), Water(), cuts, true);
+    InterpolationSettings::TABLE_TOLERANCE = 0.;
+    auto integral = make_crosssection(param, MuMinusDef(), Water(), cuts, false);
+
+    for (auto energy : { 2e3, 3.3e5, 7e8, 4e11 }) {
+        EXPECT_NEAR(table->CalculatedEdx(energy), integral->CalculatedEdx(energy),
+            integral->CalculatedEdx(energy) * 1e-3);
+        EXPECT_NEAR(table->CalculatedNdx(energy), integral->CalculatedNdx(energy),
+            integral->CalculatedNdx(energy) * 1e-3);
+    }
+    InterpolantRegistry::Clear();
+}
+
+TEST(ParallelFor, CallsAllIndices)
+{
+    InterpolationSettings::TABLE_BUILD_THREADS = 4;
+    auto calls = std::vector<std::atomic<int>>(100);
+    Helper::ParallelFor(calls.size(), [&](size_t i) {
+        // nested calls share the threads of the outer one
+        Helper::ParallelFor(3, [&](size_t) { calls[i]++; });
+    });
+    for (auto& n : calls)
+        EXPECT_EQ(n, 3);
+
+    EXPECT_THROW(Helper::ParallelFor(10,
+                     [](size_t i) {
+                         if (i == 5)
+                             throw std::invalid_argument("");
+                     }),
+        std::invalid_argument);
+    InterpolationSettings::TABLE_BUILD_THREADS = 0;
+}
+
+TEST(ParallelFor, ConcurrentNodeEvaluation)
+{
+    InterpolationSettings::TABLE_BUILD_THREADS = 4;
+    auto axis_0 = cubic_splines::ExpAxis<double>(1e2, 1e10, 20);
+    auto axis_1 = cubic_splines::LinAxis<double>(0., 1., 10);
+    std::atomic<int> calls { 0 };
+    auto f = detail::evaluate_nodes_concurrently(
+        axis_0, axis_1, [&calls](double x_0, double x_1) {
+            calls++;
+            return std::log(x_0) * x_1;
+        });
+
+    for (size_t i = 0; i < 20; ++i) {
+        for (size_t j = 0; j < 10; ++j) {
+            auto x_0 = axis_0.back_transform(i);
+            auto x_1 = axis_1.back_transform(j);
+            EXPECT_DOUBLE_EQ(f(x_0, x_1), std::log(x_0) * x_1);
+        }
+    }
+    // all nodes are evaluated once, at the first request
+    EXPECT_EQ(calls, 200);
+
+    // positions between the nodes are evaluated directly
+    EXPECT_DOUBLE_EQ(f(1e3, 0.55), std::log(1e3) * 0.55);
+    EXPECT_EQ(calls, 201);
+    InterpolationSettings::TABLE_BUILD_THREADS = 0;
+}
+
+TEST(ParallelFor, ConcurrentTableConstruction)
+{
+    // tables built concurrently are identical to the ones built sequentially
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    InterpolationSettings::TABLE_BUILD_THREADS = 1;
+    auto sequential = GetStdCrossSections(MuMinusDef(), Water(), cuts, true);
+    InterpolationSettings::TABLE_BUILD_THREADS = 4;
+    InterpolantRegistry::Clear();
+    auto concurrent = GetStdCrossSections(MuMinusDef(), Water(), cuts, true);
+    InterpolationSettings::TABLE_BUILD_THREADS = 0;
+
+    ASSERT_EQ(sequential.size(), concurrent.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        EXPECT_EQ(sequential[i]->GetHash(), concurrent[i]->GetHash());
+        for (auto energy : { 1e3, 1e6, 1e9 }) {
+            EXPECT_DOUBLE_EQ(sequential[i]->CalculatedEdx(energy),
+                concurrent[i]->CalculatedEdx(energy));
+            EXPECT_DOUBLE_EQ(sequential[i]->CalculatedNdx(energy),
+                concurrent[i]->CalculatedNdx(energy));
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
 #include "PROPOSAL/geometry/Geometry.h"
@@ -1197,6 +1198,88 @@ TEST(DistanceTo, Box)
     }
 }
 
+// sphere relying on the default, unbounded box of a geometry
+class UnboundedSphere : public Sphere {
+public:
+    using Sphere::Sphere;
+    std::pair<Cartesian3D, Cartesian3D> GetBoundingBox() const override
+    {
+        return Geometry::GetBoundingBox();
+    }
+};
+
+void CompareToLinearScan(bool with_unbounded)
+{
+    RandomGenerator::Get().SetSeed(1234);
+    auto rnd = []() { return RandomGenerator::Get().RandomDouble(); };
+
+    // world volume with many small, partly overlapping detector volumes
+    std::vector<std::shared_ptr<const Geometry>> geometries;
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e4);
+    world->SetHierarchy(0);
+    geometries.push_back(world);
+    for (int i = 0; i < 200; ++i) {
+        auto position = Cartesian3D(
+            2e3 * rnd() - 1e3, 2e3 * rnd() - 1e3, 2e3 * rnd() - 1e3);
+        std::shared_ptr<Geometry> geometry;
+        if (with_unbounded && i % 10 == 0)
+            geometry = std::make_shared<UnboundedSphere>(
+                position, 100 * rnd() + 1);
+        else if (i % 3 == 0)
+            geometry = std::make_shared<Sphere>(position, 100 * rnd() + 1);
+        else if (i % 3 == 1)
+            geometry = std::make_shared<Box>(
+                position, 200 * rnd() + 1, 200 * rnd() + 1, 200 * rnd() + 1);
+        else
+            geometry = std::make_shared<Cylinder>(
+                position, 200 * rnd() + 1, 100 * rnd() + 1);
+        geometry->SetHierarchy(1 + i % 3);
+        geometries.push_back(geometry);
+    }
+
+    auto bvh = BoundingVolumeHierarchy(geometries);
+
+    for (int i = 0; i < 10000; ++i) {
+        auto position = Cartesian3D(
+            2e3 * rnd() - 1e3, 2e3 * rnd() - 1e3, 2e3 * rnd() - 1e3);
+        auto direction = Spherical3D(1, 2 * PI * rnd(), PI * rnd());
+
+        int expected = -1;
+        for (size_t j = 0; j < geometries.size(); ++j) {
+            if (geometries[j]->IsInside(position, direction)
+                && (expected < 0
+                    || geometries[j]->GetHierarchy()
+                        > geometries[expected]->GetHierarchy()))
+                expected = j;
+        }
+        EXPECT_EQ(bvh.GetContainingGeometry(position, direction), expected);
+
+        for (unsigned int hierarchy = 0; hierarchy < 4; ++hierarchy) {
+            double expected_distance = INF;
+            for (auto& geometry : geometries) {
+                if (geometry->GetHierarchy() <= hierarchy)
+                    continue;
+                auto dist = geometry->DistanceToBorder(position, direction);
+                if (dist.first >= 0)
+                    expected_distance = std::min(expected_distance, dist.first);
+            }
+            EXPECT_EQ(bvh.DistanceToBorder(position, direction, hierarchy),
+                expected_distance);
+        }
+    }
+}
+
+TEST(BoundingVolumeHierarchy, CompareToLinearScan)
+{
+    CompareToLinearScan(false);
+}
+
+TEST(BoundingVolumeHierarchy, UnboundedGeometries)
+{
+    // geometries without a finite bounding box are tested on every query
+    CompareToLinearScan(true);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
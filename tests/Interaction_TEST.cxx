@@ -4,6 +4,7 @@
 #include "PROPOSAL/crosssection/CrossSectionBuilder.h"
 #include "PROPOSAL/crosssection/ParticleDefaultCrossSectionList.h"
 #include "PROPOSAL/math/RandomGenerator.h"
+#include "PROPOSAL/math/TableArchive.h"
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/propagation_utility/InteractionBuilder.h"
 #include "PROPOSAL/propagation_utility/PropagationUtilityIntegral.h"
@@ -126,6 +127,85 @@ TEST(TypeInteraction, Ratios)
     EXPECT_EQ(histogram_high.LowestCounter(), InteractionType::Ioniz);
 }
 
+TEST(TypeInteraction, SampleLossWithoutRates)
+{
+    // sampling without the rates of the caller has to give the
+    // same losses as sampling with the rates
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto cross = GetStdCrossSections(MuMinusDef(), StandardRock(), cuts, true);
+    auto interaction = make_interaction(cross, false);
+
+    RandomGenerator::Get().SetSeed(24601);
+    for (auto energy : { 1e3, 1e5, 1e7, 1e10 }) {
+        for (int n = 0; n < 100; ++n) {
+            auto rnd = RandomGenerator::Get().RandomDouble();
+            auto rates = interaction->Rates(energy);
+            auto expected = interaction->SampleLoss(energy, rates, rnd);
+            auto loss = interaction->SampleLoss(energy, rnd);
+            EXPECT_EQ(loss.type, expected.type);
+            EXPECT_EQ(loss.comp_hash, expected.comp_hash);
+            EXPECT_DOUBLE_EQ(loss.v_loss, expected.v_loss);
+        }
+    }
+}
+
+TEST(TypeInteraction, ChannelTable)
+{
+    // the channels chosen from the table may only differ from the exact ones
+    // close to the boundaries between the channels
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto cross = GetStdCrossSections(MuMinusDef(), FrejusRock(), cuts, true);
+    auto exact = make_interaction(cross, false);
+    InterpolationSettings::NODES_CHANNEL_TABLE = 1000;
+    auto tabulated = make_interaction(cross, false);
+    InterpolationSettings::NODES_CHANNEL_TABLE = 0;
+
+    auto samples = 0;
+    auto mismatches = 0;
+    for (auto energy : { 1e3, 3e4, 1e6, 2e8, 1e10 }) {
+        for (int n = 0; n < 1000; ++n) {
+            auto rnd = (n + 0.5) / 1000;
+            auto expected = exact->SampleLoss(energy, rnd);
+            auto loss = tabulated->SampleLoss(energy, rnd);
+            EXPECT_GT(loss.v_loss, 0);
+            EXPECT_LE(loss.v_loss, 1);
+            if (loss.type != expected.type
+                || loss.comp_hash != expected.comp_hash)
+                ++mismatches;
+            ++samples;
+        }
+    }
+    EXPECT_LT(mismatches, 0.01 * samples);
+}
+
+TEST(TypeInteraction, LazyChannelTable)
+{
+    // with lazy tables, the channel table must not build the dNdx tables of
+    // all energies on construction
+    InterpolationSettings::LAZY_TABLES = true;
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, false);
+    auto cross = GetStdCrossSections(MuMinusDef(), FrejusRock(), cuts, true);
+    auto exact = make_interaction(cross, false);
+    InterpolationSettings::NODES_CHANNEL_TABLE = 1000;
+    TableArchive::TakeCreationTimes();
+    auto tabulated = make_interaction(cross, false);
+    EXPECT_TRUE(TableArchive::TakeCreationTimes().empty());
+    InterpolationSettings::NODES_CHANNEL_TABLE = 0;
+
+    auto samples = 0;
+    auto mismatches = 0;
+    for (int n = 0; n < 1000; ++n) {
+        auto rnd = (n + 0.5) / 1000;
+        auto expected = exact->SampleLoss(1e6, rnd);
+        auto loss = tabulated->SampleLoss(1e6, rnd);
+        if (loss.type != expected.type || loss.comp_hash != expected.comp_hash)
+            ++mismatches;
+        ++samples;
+    }
+    EXPECT_LT(mismatches, 0.01 * samples);
+    InterpolationSettings::LAZY_TABLES = false;
+}
+
 TEST(EnergyInteraction, Constraints)
 {
     // sampled interaction energies should never be below the rest mass
@@ -72,6 +72,13 @@ TEST(Type_Particle_Map, GetParticleDefForType)
               particle1);
 }
 
+TEST(Type_Particle_Map, GetParticleDefForName)
+{
+    EXPECT_EQ(ParticleDef::GetParticleDefForName("TauMinus"), TauMinusDef());
+    EXPECT_THROW(ParticleDef::GetParticleDefForName("NoParticle"),
+        std::invalid_argument);
+}
+
 TEST(Type_Particle_Map, Registering)
 {
     auto particle1 = EMinusDef();
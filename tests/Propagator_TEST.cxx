@@ -10,6 +10,10 @@
 #include "PROPOSAL/geometry/Sphere.h"
 #include "PROPOSAL/particle/Particle.h"
 
+#include <algorithm>
+#include <random>
+#include <thread>
+
 using namespace PROPOSAL;
 
 TEST(Propagator, min_energy)
@@ -97,6 +101,446 @@ TEST(Propagator, RestMassDecay)
 
 }
 
+TEST(Propagator, ThreadSafePropagation)
+{
+    // Propagating with the same random engine seed has to give identical
+    // results, independent of other threads using the same propagator.
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.cont_rand = make_contrand(cross, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Moliere, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+
+    auto sector = std::make_tuple(world, prop_utility, density_distr);
+    std::vector<Sector> sec_vec = {sector};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e6;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    constexpr size_t n_threads = 4;
+    constexpr size_t n_events = 50;
+
+    auto propagate = [&](unsigned int seed) {
+        auto rng = std::mt19937(seed);
+        std::vector<ParticleState> final_states;
+        for (size_t i = 0; i < n_events; i++) {
+            auto sec = prop.Propagate(init_state, rng);
+            final_states.push_back(sec.GetTrack().back());
+            for (auto& p : sec.GetDecayProducts(rng))
+                final_states.push_back(p);
+        }
+        return final_states;
+    };
+
+    std::vector<std::vector<ParticleState>> reference;
+    for (size_t t = 0; t < n_threads; t++)
+        reference.push_back(propagate(t));
+
+    std::vector<std::vector<ParticleState>> results(n_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; t++)
+        threads.emplace_back([&, t]() { results[t] = propagate(t); });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < n_threads; t++) {
+        ASSERT_EQ(results[t].size(), reference[t].size());
+        for (size_t i = 0; i < results[t].size(); i++) {
+            EXPECT_EQ(results[t][i].energy, reference[t][i].energy);
+            EXPECT_EQ(results[t][i].position, reference[t][i].position);
+            EXPECT_EQ(results[t][i].direction, reference[t][i].direction);
+        }
+    }
+}
+
+
+TEST(Propagator, PropagateBatch)
+{
+    // The results of a batch only depend on the seed, not on the number of
+    // worker threads, and are returned in the order of the input.
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.cont_rand = make_contrand(cross, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Highland, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+
+    auto sector = std::make_tuple(world, prop_utility, density_distr);
+    std::vector<Sector> sec_vec = {sector};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    std::vector<ParticleState> init_states;
+    for (size_t i = 0; i < 100; i++) {
+        auto init_state = ParticleState();
+        init_state.energy = 1e3 * (i + 1);
+        init_state.position = Cartesian3D(0, 0, 0);
+        init_state.direction = Cartesian3D(0, 0, 1);
+        init_states.push_back(init_state);
+    }
+
+    auto serial = prop.PropagateBatch(init_states, 42, 1);
+    auto parallel = prop.PropagateBatch(init_states, 42, 3);
+
+    ASSERT_EQ(serial.size(), init_states.size());
+    ASSERT_EQ(parallel.size(), init_states.size());
+    for (size_t i = 0; i < init_states.size(); i++) {
+        EXPECT_EQ(serial[i].GetInitialState().energy, init_states[i].energy);
+        EXPECT_EQ(parallel[i].GetInitialState().energy, init_states[i].energy);
+        ASSERT_EQ(serial[i].GetTrack().size(), parallel[i].GetTrack().size());
+        EXPECT_EQ(serial[i].GetFinalState().energy,
+            parallel[i].GetFinalState().energy);
+        EXPECT_EQ(serial[i].GetFinalState().position,
+            parallel[i].GetFinalState().position);
+    }
+}
+
+namespace {
+class CountingSink : public PropagationSink {
+public:
+    size_t n_continuous = 0;
+    size_t n_stochastic = 0;
+    size_t n_decay = 0;
+    double stochastic_energy = 0;
+    ParticleState last_state;
+
+    void OnContinuousStep(const ParticleState& state) override
+    {
+        n_continuous++;
+        last_state = state;
+    }
+    void OnStochasticLoss(const ParticleState& state, InteractionType,
+        double energy_loss, size_t) override
+    {
+        n_stochastic++;
+        stochastic_energy += energy_loss;
+        last_state = state;
+    }
+    void OnDecay(const ParticleState& state) override
+    {
+        n_decay++;
+        last_state = state;
+    }
+};
+} // namespace
+
+TEST(Propagator, PropagationSink)
+{
+    // A sink has to receive exactly the steps which are stored in the
+    // Secondaries for the same random numbers.
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.cont_rand = make_contrand(cross, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Highland, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+
+    auto sector = std::make_tuple(world, prop_utility, density_distr);
+    std::vector<Sector> sec_vec = {sector};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e5;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    for (unsigned int seed = 0; seed < 100; seed++) {
+        auto rng_track = std::mt19937(seed);
+        auto track = prop.Propagate(init_state, rng_track);
+
+        auto rng_sink = std::mt19937(seed);
+        auto sink = CountingSink();
+        prop.Propagate(init_state, sink, rng_sink);
+
+        auto types = track.GetTrackTypes();
+        auto n_continuous = static_cast<size_t>(std::count(types.begin(),
+            types.end(), InteractionType::ContinuousEnergyLoss));
+        auto n_decay = static_cast<size_t>(
+            std::count(types.begin(), types.end(), InteractionType::Decay));
+        EXPECT_EQ(sink.n_continuous, n_continuous);
+        EXPECT_EQ(sink.n_decay, n_decay);
+        EXPECT_EQ(sink.n_stochastic, types.size() - n_continuous - n_decay);
+        EXPECT_EQ(sink.last_state.energy, track.GetFinalState().energy);
+
+        double stochastic_energy = 0;
+        for (auto& loss : track.GetStochasticLosses())
+            stochastic_energy += loss.energy;
+        EXPECT_NEAR(sink.stochastic_energy, stochastic_energy,
+            1e-10 * stochastic_energy);
+    }
+}
+
+TEST(Propagator, TrackRecording)
+{
+    // Reduced recording modes have to store the same initial state, final
+    // state and stochastic losses as the full track.
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.cont_rand = make_contrand(cross, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Highland, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+
+    auto sector = std::make_tuple(world, prop_utility, density_distr);
+    std::vector<Sector> sec_vec = {sector};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e5;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    for (unsigned int seed = 0; seed < 100; seed++) {
+        auto rng = std::mt19937(seed);
+        prop.SetTrackRecording(TrackRecording::Full);
+        auto full = prop.Propagate(init_state, rng);
+
+        rng = std::mt19937(seed);
+        prop.SetTrackRecording(TrackRecording::StochasticLosses);
+        auto losses = prop.Propagate(init_state, rng);
+
+        rng = std::mt19937(seed);
+        prop.SetTrackRecording(TrackRecording::Endpoints);
+        auto endpoints = prop.Propagate(init_state, rng);
+
+        for (auto& track : { losses, endpoints }) {
+            EXPECT_EQ(track.GetInitialState().energy,
+                full.GetInitialState().energy);
+            EXPECT_EQ(track.GetFinalState().energy,
+                full.GetFinalState().energy);
+            EXPECT_EQ(track.GetFinalState().position,
+                full.GetFinalState().position);
+            EXPECT_EQ(track.GetTrackTypes().back() == InteractionType::Decay,
+                full.GetTrackTypes().back() == InteractionType::Decay);
+        }
+        EXPECT_LE(endpoints.GetTrack().size(), 2u);
+        // the energy lost over the whole track is no stochastic loss
+        EXPECT_TRUE(endpoints.GetStochasticLosses().empty());
+
+        auto losses_full = full.GetStochasticLosses();
+        auto losses_reduced = losses.GetStochasticLosses();
+        ASSERT_EQ(losses_full.size(), losses_reduced.size());
+        for (size_t i = 0; i < losses_full.size(); i++) {
+            EXPECT_EQ(losses_full[i].energy, losses_reduced[i].energy);
+            EXPECT_EQ(losses_full[i].position, losses_reduced[i].position);
+        }
+        EXPECT_LE(losses.GetTrack().size(), full.GetTrack().size());
+    }
+}
+
+TEST(Propagator, PropagateIntoSecondaries)
+{
+    // Propagating into a reused output object has to give the same tracks
+    // as returning a new Secondaries object, without reallocating the track.
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+
+    auto sector = std::make_tuple(world, prop_utility, density_distr);
+    std::vector<Sector> sec_vec = {sector};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e5;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    auto rng_reference = std::mt19937(42);
+    auto rng = std::mt19937(42);
+
+    auto out = prop.Propagate(init_state, rng);
+    rng_reference = rng;
+    out.reserve(100000);
+    auto data = out.GetEnergyColumn().data();
+
+    for (size_t i = 0; i < 20; i++) {
+        auto reference = prop.Propagate(init_state, rng_reference);
+        prop.Propagate(init_state, out, rng);
+        ASSERT_EQ(out.GetTrackLength(), reference.GetTrackLength());
+        EXPECT_EQ(out.GetTrack(), reference.GetTrack());
+        EXPECT_EQ(out.GetTrackTypes(), reference.GetTrackTypes());
+        EXPECT_EQ(out.GetEnergyColumn().data(), data);
+    }
+}
+
+TEST(Propagator, Statistics)
+{
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Moliere, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+    auto detector = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e4);
+    detector->SetHierarchy(1);
+
+    std::vector<Sector> sec_vec = {
+        std::make_tuple(world, prop_utility, density_distr),
+        std::make_tuple(detector, prop_utility, density_distr)};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e6;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    auto rng = std::mt19937(1234);
+    constexpr size_t n_events = 20;
+
+    // statistics are only collected on request
+    for (size_t i = 0; i < n_events; i++)
+        prop.Propagate(init_state, rng);
+    EXPECT_EQ(prop.GetStatistics().propagations, 0);
+
+    prop.SetCollectStatistics(true);
+    auto sink = CountingSink();
+    for (size_t i = 0; i < n_events; i++)
+        prop.Propagate(init_state, sink, rng);
+    // the initial state is reported as well
+    auto n_steps = sink.n_continuous - n_events;
+
+    auto stats = prop.GetStatistics();
+    EXPECT_EQ(stats.propagations, n_events);
+    EXPECT_EQ(stats.advance_particle_calls, n_steps);
+    EXPECT_EQ(stats.advance_particle_iterations,
+        stats.advance_particle_calls + stats.invalid_steps);
+    EXPECT_GE(stats.advance_particle_max_iterations, 1);
+    EXPECT_EQ(stats.max_steps_reached, 0);
+
+    prop.ResetStatistics();
+    EXPECT_EQ(prop.GetStatistics().propagations, 0);
+    EXPECT_EQ(prop.GetStatistics().advance_particle_calls, 0);
+}
+
+TEST(Propagator, Profile)
+{
+    auto p_def = MuMinusDef();
+    auto medium = Ice();
+    auto cuts = std::make_shared<EnergyCutSettings>(500, 0.05, true);
+    auto cross = GetStdCrossSections(p_def, medium, cuts, true);
+
+    auto collection = PropagationUtility::Collection();
+    collection.interaction_calc = make_interaction(cross, true);
+    collection.displacement_calc = make_displacement(cross, true);
+    collection.time_calc = make_time(cross, p_def, true);
+    collection.scattering = make_scattering(MultipleScatteringType::Moliere, {}, p_def, medium);
+    collection.decay_calc = make_decay(cross, p_def, true);
+
+    auto prop_utility = PropagationUtility(collection);
+
+    auto density_distr = std::make_shared<Density_homogeneous>(medium);
+    auto world = std::make_shared<Sphere>(Cartesian3D(0, 0, 0), 1e20);
+    std::vector<Sector> sec_vec = {
+        std::make_tuple(world, prop_utility, density_distr)};
+
+    auto prop = Propagator(p_def, sec_vec);
+
+    auto init_state = ParticleState();
+    init_state.energy = 1e6;
+    init_state.position = Cartesian3D(0, 0, 0);
+    init_state.direction = Cartesian3D(0, 0, 1);
+
+    auto rng = std::mt19937(1234);
+    constexpr size_t n_events = 10;
+    for (size_t i = 0; i < n_events; i++)
+        prop.Propagate(init_state, rng);
+
+    auto profile = prop.GetProfile();
+    if (!PropagationProfile::IsEnabled()) {
+        EXPECT_EQ(profile.propagations, 0);
+        return;
+    }
+
+    EXPECT_EQ(profile.propagations, n_events);
+    EXPECT_GT(profile.total_seconds, 0.);
+    EXPECT_GT(profile.calls[PropagationProfile::EnergyInteraction], 0);
+    EXPECT_GT(profile.calls[PropagationProfile::DirectionsScatter], 0);
+    EXPECT_EQ(profile.calls[PropagationProfile::EnergyInteraction],
+        profile.calls[PropagationProfile::EnergyDecay]);
+
+    double phase_seconds = 0.;
+    for (auto seconds : profile.seconds)
+        phase_seconds += seconds;
+    EXPECT_LE(phase_seconds, profile.total_seconds);
+
+    prop.ResetProfile();
+    EXPECT_EQ(prop.GetProfile().propagations, 0);
+}
 
 int main(int argc, char** argv)
 {
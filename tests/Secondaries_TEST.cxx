@@ -338,6 +338,50 @@ TEST(SecondaryVector, EnergyConservation) {
     EXPECT_DOUBLE_EQ(sum_continuous_losses + sum_stochastic_losses + MuMinusDef().mass, energy);
 }
 
+TEST(SecondaryVector, ColumnAccess) {
+    auto prop = GetPropagatorStochastic();
+
+    Cartesian3D position(0, 0, 0);
+    Cartesian3D direction(0, 0, 1);
+    auto init_state = ParticleState(ParticleType::MuMinus, position, direction,
+                                    1e7, 0., 0.);
+
+    auto secondaries = prop->Propagate(init_state);
+    auto track = secondaries.GetTrack();
+    auto types = secondaries.GetTrackTypes();
+    auto hashes = secondaries.GetTargetHashes();
+
+    auto energies = secondaries.GetEnergyColumn();
+    auto times = secondaries.GetTimeColumn();
+    auto distances = secondaries.GetPropagatedDistanceColumn();
+    auto x = secondaries.GetXColumn();
+    auto y = secondaries.GetYColumn();
+    auto z = secondaries.GetZColumn();
+    auto dx = secondaries.GetDirectionXColumn();
+    auto dy = secondaries.GetDirectionYColumn();
+    auto dz = secondaries.GetDirectionZColumn();
+    auto type_column = secondaries.GetTypeColumn();
+    auto hash_column = secondaries.GetTargetHashColumn();
+
+    ASSERT_GT(track.size(), 2);
+    ASSERT_EQ(energies.size(), track.size());
+    EXPECT_EQ(track.front(), init_state);
+    for (size_t i = 0; i < track.size(); ++i) {
+        EXPECT_EQ(secondaries[i], track[i]);
+        EXPECT_EQ(energies[i], track[i].energy);
+        EXPECT_EQ(times[i], track[i].time);
+        EXPECT_EQ(distances[i], track[i].propagated_distance);
+        EXPECT_EQ(Cartesian3D(x[i], y[i], z[i]), track[i].position);
+        EXPECT_EQ(Cartesian3D(dx[i], dy[i], dz[i]), track[i].direction);
+        EXPECT_EQ(type_column[i], types[i]);
+        EXPECT_EQ(hash_column[i], hashes[i]);
+    }
+
+    // views point to the stored data, no copies are made
+    EXPECT_EQ(secondaries.GetEnergyColumn().data(), energies.data());
+    EXPECT_EQ(secondaries.GetFinalState(), track.back());
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,6 +1,13 @@
 #include "gtest/gtest.h"
 
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
+#include "PROPOSAL/propagation_utility/PropagationUtilityInterpolant.h"
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/InterpolantRegistry.h"
+#include "PROPOSAL/math/TableArchive.h"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace PROPOSAL;
 
@@ -454,3 +461,129 @@ int main(int argc, char** argv) {
 /*     double analytical_upper = E_i * std::exp(xi); */
 /*     EXPECT_NEAR(interpolant.GetUpperLimit(E_i, xi), analytical_upper, analytical_upper*1e-5); */
 /* } */
+
+TEST(Calculate, Segments)
+{
+    auto integrand = [](double x) -> double { return -1 / x; };
+    double lower_lim = 100;
+
+    for (auto lazy : { false, true }) {
+        InterpolationSettings::LAZY_TABLES = lazy;
+        for (auto reverse : { false, true }) {
+            auto interpolant = UtilityInterpolant(integrand, lower_lim, 4325465);
+            interpolant.BuildTables("unittest_interpolant_", 500, reverse);
+
+            for (double logE_i = 2.05; logE_i < 14; logE_i += 0.3) {
+                double E_i = std::pow(10, logE_i);
+                for (double logE_f = 2; logE_f < logE_i; logE_f += 0.3) {
+                    double E_f = std::pow(10, logE_f);
+                    double analytical = std::log(E_i) - std::log(E_f);
+                    EXPECT_NEAR(interpolant.Calculate(E_i, E_f), analytical,
+                        analytical * 1e-5);
+                }
+                // with lazy tables, the energy is also searched in the
+                // segments below E_i
+                for (auto rnd : { 0.1, 1., 5., 10. }) {
+                    if (rnd > std::log(E_i / lower_lim))
+                        continue;
+                    auto E_f = E_i * std::exp(-rnd);
+                    EXPECT_NEAR(interpolant.GetUpperLimit(E_i, rnd), E_f,
+                        E_f * 1e-4);
+                }
+            }
+        }
+    }
+    InterpolationSettings::LAZY_TABLES = false;
+}
+
+TEST(Calculate, PrecomputedSegments)
+{
+    // precomputed lazy tables have to consist of the same segments as the
+    // lazy tables, built on construction
+    auto integrand = [](double x) -> double { return -1 / x; };
+    double lower_lim = 100;
+    auto names = [](std::vector<TableArchive::CreationTime> times) {
+        auto names = std::vector<std::string>();
+        for (auto const& time : times)
+            names.push_back(time.name);
+        std::sort(names.begin(), names.end());
+        return names;
+    };
+
+    InterpolationSettings::LAZY_TABLES = true;
+    InterpolantRegistry::Clear();
+    TableArchive::TakeCreationTimes();
+    auto lazy = UtilityInterpolant(integrand, lower_lim, 4325465);
+    lazy.BuildTables("unittest_precomputed_", 500, false);
+    EXPECT_TRUE(TableArchive::TakeCreationTimes().empty());
+    lazy.Calculate(InterpolationSettings::UPPER_ENERGY_LIM, lower_lim);
+    auto lazy_names = names(TableArchive::TakeCreationTimes());
+    EXPECT_GT(lazy_names.size(), 1u);
+
+    InterpolationSettings::PRECOMPUTE_LAZY_TABLES = true;
+    InterpolantRegistry::Clear();
+    auto precomputed = UtilityInterpolant(integrand, lower_lim, 4325465);
+    precomputed.BuildTables("unittest_precomputed_", 500, false);
+    EXPECT_EQ(names(TableArchive::TakeCreationTimes()), lazy_names);
+
+    InterpolationSettings::PRECOMPUTE_LAZY_TABLES = false;
+    InterpolationSettings::LAZY_TABLES = false;
+}
+
+TEST(GetUpperLimit, InverseTables)
+{
+    auto integrand = [](double x) -> double {
+        return -1 / x - 1e-2 / std::sqrt(x);
+    };
+    double lower_lim = 100;
+
+    for (auto reverse : { false, true }) {
+        auto solved = UtilityInterpolant(integrand, lower_lim, 8675309);
+        solved.BuildTables("unittest_inverse_", 500, reverse);
+        InterpolationSettings::UTILITY_INVERSE_TABLES = true;
+        auto inverse = UtilityInterpolant(integrand, lower_lim, 8675309);
+        inverse.BuildTables("unittest_inverse_", 500, reverse);
+        InterpolationSettings::UTILITY_INVERSE_TABLES = false;
+
+        for (double logE_i = 2.05; logE_i < 14; logE_i += 0.3) {
+            double E_i = std::pow(10, logE_i);
+            auto max_rnd = solved.Calculate(E_i, lower_lim);
+            for (auto fraction : { 1e-4, 0.01, 0.3, 0.9, 1. }) {
+                auto rnd = fraction * max_rnd;
+                auto E_f = solved.GetUpperLimit(E_i, rnd);
+                EXPECT_NEAR(inverse.GetUpperLimit(E_i, rnd), E_f, E_f * 1e-4);
+            }
+        }
+    }
+}
+
+TEST(GetUpperLimit, InverseTablesSmallLosses)
+{
+    // small losses are far below the accuracy of the inverse itself, so
+    // the relative error of the loss has to be checked
+    auto integrand = [](double x) -> double {
+        return -1 / x - 1e-2 / std::sqrt(x);
+    };
+    double lower_lim = 100;
+
+    for (auto reverse : { false, true }) {
+        auto solved = UtilityInterpolant(integrand, lower_lim, 8675309);
+        solved.BuildTables("unittest_inverse_", 500, reverse);
+        InterpolationSettings::UTILITY_INVERSE_TABLES = true;
+        auto inverse = UtilityInterpolant(integrand, lower_lim, 8675309);
+        inverse.BuildTables("unittest_inverse_", 500, reverse);
+        InterpolationSettings::UTILITY_INVERSE_TABLES = false;
+
+        for (double logE_i = 2.05; logE_i < 14; logE_i += 0.3) {
+            double E_i = std::pow(10, logE_i);
+            auto max_rnd = solved.Calculate(E_i, lower_lim);
+            for (auto fraction : { 1e-9, 1e-7, 1e-5 }) {
+                auto rnd = fraction * max_rnd;
+                auto loss = E_i - solved.GetUpperLimit(E_i, rnd);
+                ASSERT_GT(loss, 0);
+                EXPECT_NEAR(E_i - inverse.GetUpperLimit(E_i, rnd), loss,
+                    loss * 1e-3);
+            }
+        }
+    }
+}